@@ -486,9 +486,9 @@ void HTS_SStreamSet_clear(HTS_SStreamSet * sss);
 typedef struct _HTS_SMatrices {
    double **mean;               /* mean vector sequence */
    double **ivar;               /* inverse diag variance sequence */
-   double *g;                   /* vector used in the forward substitution */
-   double **wuw;                /* W' U^-1 W  */
-   double *wum;                 /* W' U^-1 mu */
+   double *g;                   /* vector used in the forward substitution ([frame][dimension]) */
+   double *wuw;                 /* W' U^-1 W  ([frame][band][dimension]) */
+   double *wum;                 /* W' U^-1 mu ([frame][dimension]) */
 } HTS_SMatrices;
 
 /* HTS_PStream: Individual PDF stream. */
@@ -508,6 +508,11 @@ typedef struct _HTS_PStream {
    double *gv_vari;             /* variance vector of GV */
    HTS_Boolean *gv_switch;      /* GV flag sequence */
    int gv_length;               /* frame length for GV calculation */
+   int request_length;          /* # of frames requested (for incremental generation) */
+   int forward_length;          /* # of frames factorized and forward substituted (for incremental generation) */
+   int final_length;            /* # of frames whose parameters are final (for incremental generation) */
+   double *gv_sum;              /* sum of static features over GV frames (for incremental GV) */
+   double *gv_sqr;              /* sum of squared static features over GV frames (for incremental GV) */
 } HTS_PStream;
 
 /* HTS_PStreamSet: Set of PDF streams. */
@@ -515,6 +520,8 @@ typedef struct _HTS_PStreamSet {
    HTS_PStream *pstream;        /* PDF streams */
    int nstream;                 /* # of PDF streams */
    int total_frame;             /* total frame */
+   int lookahead;               /* look-ahead frames for incremental generation (0: whole utterance) */
+   int request_frame;           /* # of frames requested (for incremental generation) */
 } HTS_PStreamSet;
 
 /*  ----------------------- pstream method ------------------------  */
@@ -525,6 +532,15 @@ void HTS_PStreamSet_initialize(HTS_PStreamSet * pss);
 /* HTS_PStreamSet_create: parameter generation using GV weight */
 HTS_Boolean HTS_PStreamSet_create(HTS_PStreamSet * pss, HTS_SStreamSet * sss, double *msd_threshold, double *gv_weight);
 
+/* HTS_PStreamSet_create_with_threads: parameter generation using GV weight on up to num_threads threads */
+HTS_Boolean HTS_PStreamSet_create_with_threads(HTS_PStreamSet * pss, HTS_SStreamSet * sss, double *msd_threshold, double *gv_weight, int num_threads);
+
+/* HTS_PStreamSet_create_incremental: parameter generation with look-ahead frames (generated on one thread) */
+HTS_Boolean HTS_PStreamSet_create_incremental(HTS_PStreamSet * pss, HTS_SStreamSet * sss, double *msd_threshold, double *gv_weight, int lookahead);
+
+/* HTS_PStreamSet_generate: make parameters of the first total_frame frames final (for incremental generation) */
+void HTS_PStreamSet_generate(HTS_PStreamSet * pss, int total_frame);
+
 /* HTS_PStreamSet_get_nstream: get number of stream */
 int HTS_PStreamSet_get_nstream(HTS_PStreamSet * pss);
 
@@ -534,10 +550,10 @@ int HTS_PStreamSet_get_static_length(HTS_PStreamSet * pss, int stream_index);
 /* HTS_PStreamSet_get_total_frame: get total number of frame */
 int HTS_PStreamSet_get_total_frame(HTS_PStreamSet * pss);
 
-/* HTS_PStreamSet_get_parameter: get parameter */
+/* HTS_PStreamSet_get_parameter: get parameter (frames which are not final yet are generated first) */
 double HTS_PStreamSet_get_parameter(HTS_PStreamSet * pss, int stream_index, int frame_index, int vector_index);
 
-/* HTS_PStreamSet_get_parameter_vector: get parameter vector */
+/* HTS_PStreamSet_get_parameter_vector: get parameter vector (frames which are not final yet are generated first) */
 double *HTS_PStreamSet_get_parameter_vector(HTS_PStreamSet * pss, int stream_index, int frame_index);
 
 /* HTS_PStreamSet_get_msd_flag: get generated MSD flag per frame */
@@ -610,6 +626,8 @@ typedef struct _HTS_Global {
    double *gv_weight;           /* GV weights */
    HTS_Boolean stop;            /* stop flag */
    double volume;               /* volume */
+   int num_threads;             /* # of threads for parameter generation */
+   int lookahead;               /* look-ahead frames for incremental parameter generation */
 } HTS_Global;
 
 /* HTS_Engine: Engine itself. */
@@ -703,6 +721,12 @@ void HTS_Engine_set_stop_flag(HTS_Engine * engine, HTS_Boolean b);
 /* HTS_Engine_set_volume: set volume */
 void HTS_Engine_set_volume(HTS_Engine * engine, double f);
 
+/* HTS_Engine_set_num_threads: set number of threads for parameter generation (not used with look-ahead) */
+void HTS_Engine_set_num_threads(HTS_Engine * engine, int i);
+
+/* HTS_Engine_set_lookahead: set look-ahead frames for incremental parameter generation (0: whole utterance) */
+void HTS_Engine_set_lookahead(HTS_Engine * engine, int i);
+
 /* HTS_Engine_get_total_state: get total number of state */
 int HTS_Engine_get_total_state(HTS_Engine * engine);
 
@@ -781,6 +805,7 @@ typedef struct _HTS_Vocoder {
    double p;                    /* used in excitation generation */
    double inc;                  /* used in excitation generation */
    double *pulse_list;          /* used in excitation generation */
+   double *excite_buff;         /* excitation of a frame */
    int sw;                      /* switch used in random generator */
    int x;                       /* excitation signal */
    double *freqt_buff;          /* used in freqt */
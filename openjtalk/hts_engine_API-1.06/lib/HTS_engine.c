@@ -95,6 +95,10 @@ void HTS_Engine_initialize(HTS_Engine * engine, int nstream)
    engine->global.stop = FALSE;
    /* volume */
    engine->global.volume = 1.0;
+   /* number of threads */
+   engine->global.num_threads = 1;
+   /* look-ahead for incremental parameter generation */
+   engine->global.lookahead = 0;
 
    /* initialize audio */
    HTS_Audio_initialize(&engine->audio, engine->global.sampling_rate, engine->global.audio_buff_size);
@@ -397,6 +401,22 @@ void HTS_Engine_set_volume(HTS_Engine * engine, double f)
    engine->global.volume = f;
 }
 
+/* HTS_Engine_set_num_threads: set number of threads for parameter generation (not used with look-ahead) */
+void HTS_Engine_set_num_threads(HTS_Engine * engine, int i)
+{
+   if (i < 1)
+      i = 1;
+   engine->global.num_threads = i;
+}
+
+/* HTS_Engine_set_lookahead: set look-ahead frames for incremental parameter generation (0: whole utterance) */
+void HTS_Engine_set_lookahead(HTS_Engine * engine, int i)
+{
+   if (i < 0)
+      i = 0;
+   engine->global.lookahead = i;
+}
+
 /* HTS_Engine_get_total_state: get total number of state */
 int HTS_Engine_get_total_state(HTS_Engine * engine)
 {
@@ -466,7 +486,21 @@ HTS_Boolean HTS_Engine_create_sstream(HTS_Engine * engine)
 /* HTS_Engine_create_pstream: generate speech parameter vector sequence */
 HTS_Boolean HTS_Engine_create_pstream(HTS_Engine * engine)
 {
-   return HTS_PStreamSet_create(&engine->pss, &engine->sss, engine->global.msd_threshold, engine->global.gv_weight);
+   int i;
+
+   if (engine->global.lookahead > 0) {
+      if (engine->global.num_threads > 1)
+         HTS_error(0, "HTS_Engine_create_pstream: Incremental parameter generation runs on one thread.\n");
+      /* the frames are scaled to the GV without its iterations, so a longer
+         look-ahead does not bring them closer to the whole utterance */
+      for (i = 0; i < HTS_SStreamSet_get_nstream(&engine->sss); i++)
+         if (HTS_SStreamSet_use_gv(&engine->sss, i)) {
+            HTS_error(0, "HTS_Engine_create_pstream: GV is only approximated in incremental parameter generation.\n");
+            break;
+         }
+      return HTS_PStreamSet_create_incremental(&engine->pss, &engine->sss, engine->global.msd_threshold, engine->global.gv_weight, engine->global.lookahead);
+   }
+   return HTS_PStreamSet_create_with_threads(&engine->pss, &engine->sss, engine->global.msd_threshold, engine->global.gv_weight, engine->global.num_threads);
 }
 
 /* HTS_Engine_create_gstream: synthesis speech */
@@ -68,12 +68,34 @@ void HTS_GStreamSet_initialize(HTS_GStreamSet * gss)
    gss->gspeech = NULL;
 }
 
+/* HTS_GStreamSet_copy_parameter: copy generated parameter of a frame */
+static void HTS_GStreamSet_copy_parameter(HTS_GStreamSet * gss, HTS_PStreamSet * pss, int frame, int *msd_frame)
+{
+   int i, k;
+
+   HTS_PStreamSet_generate(pss, frame + 1);
+   for (i = 0; i < gss->nstream; i++) {
+      if (HTS_PStreamSet_is_msd(pss, i)) {      /* for MSD */
+         if (HTS_PStreamSet_get_msd_flag(pss, i, frame)) {
+            for (k = 0; k < gss->gstream[i].static_length; k++)
+               gss->gstream[i].par[frame][k] = HTS_PStreamSet_get_parameter(pss, i, msd_frame[i], k);
+            msd_frame[i]++;
+         } else
+            for (k = 0; k < gss->gstream[i].static_length; k++)
+               gss->gstream[i].par[frame][k] = LZERO;
+      } else {                  /* for non MSD */
+         for (k = 0; k < gss->gstream[i].static_length; k++)
+            gss->gstream[i].par[frame][k] = HTS_PStreamSet_get_parameter(pss, i, frame, k);
+      }
+   }
+}
+
 /* HTS_GStreamSet_create: generate speech */
 /* (stream[0] == spectrum && stream[1] == lf0) */
 HTS_Boolean HTS_GStreamSet_create(HTS_GStreamSet * gss, HTS_PStreamSet * pss, int stage, HTS_Boolean use_log_gain, int sampling_rate, int fperiod, double alpha, double beta, HTS_Boolean * stop, double volume, HTS_Audio * audio)
 {
-   int i, j, k;
-   int msd_frame;
+   int i, j;
+   int *msd_frame;
    HTS_Vocoder v;
    int nlpf = 0;
    double *lpf = NULL;
@@ -97,24 +119,6 @@ HTS_Boolean HTS_GStreamSet_create(HTS_GStreamSet * gss, HTS_PStreamSet * pss, in
    }
    gss->gspeech = (short *) HTS_calloc(gss->total_nsample, sizeof(short));
 
-   /* copy generated parameter */
-   for (i = 0; i < gss->nstream; i++) {
-      if (HTS_PStreamSet_is_msd(pss, i)) {      /* for MSD */
-         for (j = 0, msd_frame = 0; j < gss->total_frame; j++)
-            if (HTS_PStreamSet_get_msd_flag(pss, i, j)) {
-               for (k = 0; k < gss->gstream[i].static_length; k++)
-                  gss->gstream[i].par[j][k] = HTS_PStreamSet_get_parameter(pss, i, msd_frame, k);
-               msd_frame++;
-            } else
-               for (k = 0; k < gss->gstream[i].static_length; k++)
-                  gss->gstream[i].par[j][k] = LZERO;
-      } else {                  /* for non MSD */
-         for (j = 0; j < gss->total_frame; j++)
-            for (k = 0; k < gss->gstream[i].static_length; k++)
-               gss->gstream[i].par[j][k] = HTS_PStreamSet_get_parameter(pss, i, j, k);
-      }
-   }
-
    /* check */
    if (gss->nstream != 2 && gss->nstream != 3) {
       HTS_error(1, "HTS_GStreamSet_create: The number of streams should be 2 or 3.\n");
@@ -132,11 +136,15 @@ HTS_Boolean HTS_GStreamSet_create(HTS_GStreamSet * gss, HTS_PStreamSet * pss, in
       return FALSE;
    }
 
-   /* synthesize speech waveform */
+   /* synthesize speech waveform; generated parameter is copied frame by frame
+      so that incremental parameter generation only runs ahead of the vocoder
+      by its look-ahead */
+   msd_frame = (int *) HTS_calloc(gss->nstream, sizeof(int));
    HTS_Vocoder_initialize(&v, gss->gstream[0].static_length - 1, stage, use_log_gain, sampling_rate, fperiod);
    if (gss->nstream >= 3)
       nlpf = (gss->gstream[2].static_length - 1) / 2;
    for (i = 0; i < gss->total_frame && (*stop) == FALSE; i++) {
+      HTS_GStreamSet_copy_parameter(gss, pss, i, msd_frame);
       if (gss->nstream >= 3)
          lpf = &gss->gstream[2].par[i][0];
       HTS_Vocoder_synthesize(&v, gss->gstream[0].static_length - 1, gss->gstream[1].par[i][0], &gss->gstream[0].par[i][0], nlpf, lpf, alpha, beta, volume, &gss->gspeech[i * fperiod], audio);
@@ -145,6 +153,11 @@ HTS_Boolean HTS_GStreamSet_create(HTS_GStreamSet * gss, HTS_PStreamSet * pss, in
    if (audio)
       HTS_Audio_flush(audio);
 
+   /* copy generated parameter of the rest frames */
+   for (j = i; j < gss->total_frame; j++)
+      HTS_GStreamSet_copy_parameter(gss, pss, j, msd_frame);
+   HTS_free(msd_frame);
+
    return TRUE;
 }
 
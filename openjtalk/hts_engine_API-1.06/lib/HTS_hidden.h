@@ -124,6 +124,10 @@ void HTS_free(void *p);
 #define W2       1.0
 #define GV_MAX_ITERATION 5
 
+/* threads: minimum frames x static dimensions solved by each thread, below which
+   starting a thread costs more than it saves */
+#define MIN_WORK_PER_THREAD 4096
+
 /*  -------------------------- vocoder ----------------------------  */
 
 #ifndef PI
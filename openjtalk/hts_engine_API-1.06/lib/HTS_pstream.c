@@ -57,6 +57,10 @@ HTS_PSTREAM_C_START;
 
 #include <math.h>               /* for sqrt() */
 
+#ifdef HAVE_PTHREAD_H
+#include <pthread.h>
+#endif                          /* HAVE_PTHREAD_H */
+
 /* hts_engine libraries */
 #include "HTS_hidden.h"
 
@@ -75,188 +79,456 @@ static double HTS_finv(const double x)
    return (1.0 / x);
 }
 
+/* wum, g and wuw of HTS_SMatrices hold the static dimensions from start to end - 1
+   side by side: wum[t * n + l], g[t * n + l] and wuw[(t * width + i) * n + l] belong
+   to dimension start + l, where n = end - start. All dimensions are solved in lockstep
+   with the innermost loops running over l on contiguous memory, and each dimension
+   goes through the same arithmetic as when it was solved on its own. The first four
+   kernels also take a range of frames from from to to - 1; W'U^{-1}W, its LDL factor
+   and g of frame t only depend on frames up to t, so they can be extended piece by
+   piece for incremental generation, where backward substitution then runs on a
+   window whose following frames are approximated. */
+
 /* HTS_PStream_calc_wuw_and_wum: calcurate W'U^{-1}W and W'U^{-1}M */
-static void HTS_PStream_calc_wuw_and_wum(HTS_PStream * pst, const int m)
+static void HTS_PStream_calc_wuw_and_wum(HTS_PStream * pst, const int start, const int end, const int from, const int to)
 {
-   int t, i, j, k;
-   double wu;
+   int t, i, j, k, l;
+   const int n = end - start;
+   double c, c2;
+   double *wum, *wuw;
+   const double *ivar, *mean;
+
+   for (t = from; t < to; t++) {
+      wum = pst->sm.wum + t * n;
+      wuw = pst->sm.wuw + t * pst->width * n;
 
-   for (t = 0; t < pst->length; t++) {
       /* initialize */
-      pst->sm.wum[t] = 0.0;
-      for (i = 0; i < pst->width; i++)
-         pst->sm.wuw[t][i] = 0.0;
+      for (l = 0; l < n; l++)
+         wum[l] = 0.0;
+      for (i = 0; i < pst->width * n; i++)
+         wuw[i] = 0.0;
 
       /* calc WUW & WUM */
       for (i = 0; i < pst->win_size; i++)
          for (j = pst->win_l_width[i]; j <= pst->win_r_width[i]; j++)
             if ((t + j >= 0) && (t + j < pst->length)
                 && (pst->win_coefficient[i][-j] != 0.0)) {
-               wu = pst->win_coefficient[i][-j] * pst->sm.ivar[t + j][i * pst->static_length + m];
-               pst->sm.wum[t] += wu * pst->sm.mean[t + j][i * pst->static_length + m];
+               c = pst->win_coefficient[i][-j];
+               ivar = pst->sm.ivar[t + j] + i * pst->static_length + start;
+               mean = pst->sm.mean[t + j] + i * pst->static_length + start;
+               for (l = 0; l < n; l++)
+                  wum[l] += c * ivar[l] * mean[l];
                for (k = 0; (k < pst->width) && (t + k < pst->length); k++)
                   if ((k - j <= pst->win_r_width[i])
-                      && (pst->win_coefficient[i][k - j] != 0.0))
-                     pst->sm.wuw[t][k] += wu * pst->win_coefficient[i][k - j];
+                      && (pst->win_coefficient[i][k - j] != 0.0)) {
+                     c2 = pst->win_coefficient[i][k - j];
+                     for (l = 0; l < n; l++)
+                        wuw[k * n + l] += c * ivar[l] * c2;
+                  }
             }
    }
 }
 
 
 /* HTS_PStream_ldl_factorization: Factorize W'*U^{-1}*W to L*D*L' (L: lower triangular, D: diagonal) */
-static void HTS_PStream_ldl_factorization(HTS_PStream * pst)
+static void HTS_PStream_ldl_factorization(HTS_PStream * pst, const int start, const int end, const int from, const int to)
 {
-   int t, i, j;
-
-   for (t = 0; t < pst->length; t++) {
-      for (i = 1; (i < pst->width) && (t >= i); i++)
-         pst->sm.wuw[t][0] -= pst->sm.wuw[t - i][i] * pst->sm.wuw[t - i][i] * pst->sm.wuw[t - i][0];
+   int t, i, j, l;
+   const int n = end - start;
+   const int band = pst->width * n;
+   double *wt;
+   const double *wp;
+
+   for (t = from; t < to; t++) {
+      wt = pst->sm.wuw + t * band;
+      for (i = 1; (i < pst->width) && (t >= i); i++) {
+         wp = pst->sm.wuw + (t - i) * band;
+         for (l = 0; l < n; l++)
+            wt[l] -= wp[i * n + l] * wp[i * n + l] * wp[l];
+      }
 
       for (i = 1; i < pst->width; i++) {
-         for (j = 1; (i + j < pst->width) && (t >= j); j++)
-            pst->sm.wuw[t][i] -= pst->sm.wuw[t - j][j] * pst->sm.wuw[t - j][i + j] * pst->sm.wuw[t - j][0];
-         pst->sm.wuw[t][i] /= pst->sm.wuw[t][0];
+         for (j = 1; (i + j < pst->width) && (t >= j); j++) {
+            wp = pst->sm.wuw + (t - j) * band;
+            for (l = 0; l < n; l++)
+               wt[i * n + l] -= wp[j * n + l] * wp[(i + j) * n + l] * wp[l];
+         }
+         for (l = 0; l < n; l++)
+            wt[i * n + l] /= wt[l];
       }
    }
 }
 
 /* HTS_PStream_forward_substitution: forward subtitution for mlpg */
-static void HTS_PStream_forward_substitution(HTS_PStream * pst)
+static void HTS_PStream_forward_substitution(HTS_PStream * pst, const int start, const int end, const int from, const int to)
 {
-   int t, i;
-
-   for (t = 0; t < pst->length; t++) {
-      pst->sm.g[t] = pst->sm.wum[t];
-      for (i = 1; (i < pst->width) && (t >= i); i++)
-         pst->sm.g[t] -= pst->sm.wuw[t - i][i] * pst->sm.g[t - i];
+   int t, i, l;
+   const int n = end - start;
+   double *gt;
+   const double *wp, *gp;
+
+   for (t = from; t < to; t++) {
+      gt = pst->sm.g + t * n;
+      for (l = 0; l < n; l++)
+         gt[l] = pst->sm.wum[t * n + l];
+      for (i = 1; (i < pst->width) && (t >= i); i++) {
+         wp = pst->sm.wuw + ((t - i) * pst->width + i) * n;
+         gp = pst->sm.g + (t - i) * n;
+         for (l = 0; l < n; l++)
+            gt[l] -= wp[l] * gp[l];
+      }
    }
 }
 
-/* HTS_PStream_backward_substitution: backward subtitution for mlpg */
-static void HTS_PStream_backward_substitution(HTS_PStream * pst, const int m)
+/* HTS_PStream_backward_substitution: backward subtitution for mlpg (par of frames from to onward is used as given) */
+static void HTS_PStream_backward_substitution(HTS_PStream * pst, const int start, const int end, const int from, const int to)
 {
-   int t, i;
-
-   for (t = pst->length - 1; t >= 0; t--) {
-      pst->par[t][m] = pst->sm.g[t] / pst->sm.wuw[t][0];
-      for (i = 1; (i < pst->width) && (t + i < pst->length); i++)
-         pst->par[t][m] -= pst->sm.wuw[t][i] * pst->par[t + i][m];
+   int t, i, l;
+   const int n = end - start;
+   double *pt;
+   const double *wt, *gt, *pp;
+
+   for (t = to - 1; t >= from; t--) {
+      pt = pst->par[t] + start;
+      wt = pst->sm.wuw + t * pst->width * n;
+      gt = pst->sm.g + t * n;
+      for (l = 0; l < n; l++)
+         pt[l] = gt[l] / wt[l];
+      for (i = 1; (i < pst->width) && (t + i < pst->length); i++) {
+         pp = pst->par[t + i] + start;
+         for (l = 0; l < n; l++)
+            pt[l] -= wt[i * n + l] * pp[l];
+      }
    }
 }
 
 /* HTS_PStream_calc_gv: subfunction for mlpg using GV */
-static void HTS_PStream_calc_gv(HTS_PStream * pst, const int m, double *mean, double *vari)
+static void HTS_PStream_calc_gv(HTS_PStream * pst, const int start, const int end, double *mean, double *vari)
 {
-   int t;
+   int t, l;
+   const int n = end - start;
+   const double *pt;
 
-   *mean = 0.0;
+   for (l = 0; l < n; l++)
+      mean[l] = 0.0;
    for (t = 0; t < pst->length; t++)
-      if (pst->gv_switch[t])
-         *mean += pst->par[t][m];
-   *mean /= pst->gv_length;
-   *vari = 0.0;
+      if (pst->gv_switch[t]) {
+         pt = pst->par[t] + start;
+         for (l = 0; l < n; l++)
+            mean[l] += pt[l];
+      }
+   for (l = 0; l < n; l++)
+      mean[l] /= pst->gv_length;
+   for (l = 0; l < n; l++)
+      vari[l] = 0.0;
    for (t = 0; t < pst->length; t++)
-      if (pst->gv_switch[t])
-         *vari += (pst->par[t][m] - *mean) * (pst->par[t][m] - *mean);
-   *vari /= pst->gv_length;
+      if (pst->gv_switch[t]) {
+         pt = pst->par[t] + start;
+         for (l = 0; l < n; l++)
+            vari[l] += (pt[l] - mean[l]) * (pt[l] - mean[l]);
+      }
+   for (l = 0; l < n; l++)
+      vari[l] /= pst->gv_length;
 }
 
 /* HTS_PStream_conv_gv: subfunction for mlpg using GV */
-static void HTS_PStream_conv_gv(HTS_PStream * pst, const int m)
+static void HTS_PStream_conv_gv(HTS_PStream * pst, const int start, const int end, double *mean, double *ratio)
 {
-   int t;
-   double ratio;
-   double mean;
-   double vari;
+   int t, l;
+   const int n = end - start;
+   double *pt;
 
-   HTS_PStream_calc_gv(pst, m, &mean, &vari);
-   ratio = sqrt(pst->gv_mean[m] / vari);
+   HTS_PStream_calc_gv(pst, start, end, mean, ratio);
+   for (l = 0; l < n; l++)
+      ratio[l] = sqrt(pst->gv_mean[start + l] / ratio[l]);
    for (t = 0; t < pst->length; t++)
-      if (pst->gv_switch[t])
-         pst->par[t][m] = ratio * (pst->par[t][m] - mean) + mean;
+      if (pst->gv_switch[t]) {
+         pt = pst->par[t] + start;
+         for (l = 0; l < n; l++)
+            pt[l] = ratio[l] * (pt[l] - mean[l]) + mean[l];
+      }
 }
 
 /* HTS_PStream_calc_derivative: subfunction for mlpg using GV */
-static double HTS_PStream_calc_derivative(HTS_PStream * pst, const int m)
+static void HTS_PStream_calc_derivative(HTS_PStream * pst, const int start, const int end, double *buff, double *obj)
 {
-   int t, i;
-   double mean;
-   double vari;
-   double dv;
+   int t, i, l;
+   const int n = end - start;
+   double *mean = buff;
+   double *vari = buff + n;
+   double *dv = buff + 2 * n;
+   double *gvobj = buff + 3 * n;
+   double *gt;
+   const double *wt, *wp, *wum, *pt, *pp;
+   const double *gv_mean = pst->gv_mean + start;
+   const double *gv_vari = pst->gv_vari + start;
    double h;
-   double gvobj;
-   double hmmobj;
    const double w = 1.0 / (pst->win_size * pst->length);
 
-   HTS_PStream_calc_gv(pst, m, &mean, &vari);
-   gvobj = -0.5 * W2 * vari * pst->gv_vari[m] * (vari - 2.0 * pst->gv_mean[m]);
-   dv = -2.0 * pst->gv_vari[m] * (vari - pst->gv_mean[m]) / pst->length;
+   HTS_PStream_calc_gv(pst, start, end, mean, vari);
+   for (l = 0; l < n; l++) {
+      gvobj[l] = -0.5 * W2 * vari[l] * gv_vari[l] * (vari[l] - 2.0 * gv_mean[l]);
+      dv[l] = -2.0 * gv_vari[l] * (vari[l] - gv_mean[l]) / pst->length;
+   }
 
    for (t = 0; t < pst->length; t++) {
-      pst->sm.g[t] = pst->sm.wuw[t][0] * pst->par[t][m];
+      gt = pst->sm.g + t * n;
+      wt = pst->sm.wuw + t * pst->width * n;
+      pt = pst->par[t] + start;
+      for (l = 0; l < n; l++)
+         gt[l] = wt[l] * pt[l];
       for (i = 1; i < pst->width; i++) {
-         if (t + i < pst->length)
-            pst->sm.g[t] += pst->sm.wuw[t][i] * pst->par[t + i][m];
-         if (t + 1 > i)
-            pst->sm.g[t] += pst->sm.wuw[t - i][i] * pst->par[t - i][m];
+         if (t + i < pst->length) {
+            pp = pst->par[t + i] + start;
+            for (l = 0; l < n; l++)
+               gt[l] += wt[i * n + l] * pp[l];
+         }
+         if (t + 1 > i) {
+            wp = pst->sm.wuw + ((t - i) * pst->width + i) * n;
+            pp = pst->par[t - i] + start;
+            for (l = 0; l < n; l++)
+               gt[l] += wp[l] * pp[l];
+         }
       }
    }
 
-   for (t = 0, hmmobj = 0.0; t < pst->length; t++) {
-      hmmobj += W1 * w * pst->par[t][m] * (pst->sm.wum[t] - 0.5 * pst->sm.g[t]);
-      h = -W1 * w * pst->sm.wuw[t][1 - 1] - W2 * 2.0 / (pst->length * pst->length) * ((pst->length - 1) * pst->gv_vari[m] * (vari - pst->gv_mean[m]) + 2.0 * pst->gv_vari[m] * (pst->par[t][m] - mean) * (pst->par[t][m] - mean));
-      if (pst->gv_switch[t])
-         pst->sm.g[t] = 1.0 / h * (W1 * w * (-pst->sm.g[t] + pst->sm.wum[t]) + W2 * dv * (pst->par[t][m] - mean));
-      else
-         pst->sm.g[t] = 1.0 / h * (W1 * w * (-pst->sm.g[t] + pst->sm.wum[t]));
+   for (l = 0; l < n; l++)
+      obj[l] = 0.0;
+   for (t = 0; t < pst->length; t++) {
+      gt = pst->sm.g + t * n;
+      wt = pst->sm.wuw + t * pst->width * n;
+      wum = pst->sm.wum + t * n;
+      pt = pst->par[t] + start;
+      for (l = 0; l < n; l++) {
+         obj[l] += W1 * w * pt[l] * (wum[l] - 0.5 * gt[l]);
+         h = -W1 * w * wt[l] - W2 * 2.0 / (pst->length * pst->length) * ((pst->length - 1) * gv_vari[l] * (vari[l] - gv_mean[l]) + 2.0 * gv_vari[l] * (pt[l] - mean[l]) * (pt[l] - mean[l]));
+         if (pst->gv_switch[t])
+            gt[l] = 1.0 / h * (W1 * w * (-gt[l] + wum[l]) + W2 * dv[l] * (pt[l] - mean[l]));
+         else
+            gt[l] = 1.0 / h * (W1 * w * (-gt[l] + wum[l]));
+      }
    }
 
-   return (-(hmmobj + gvobj));
+   for (l = 0; l < n; l++)
+      obj[l] = -(obj[l] + gvobj[l]);
 }
 
 /* HTS_PStream_gv_parmgen: function for mlpg using GV */
-static void HTS_PStream_gv_parmgen(HTS_PStream * pst, const int m)
+static void HTS_PStream_gv_parmgen(HTS_PStream * pst, const int start, const int end)
 {
-   int t, i;
-   double step = STEPINIT;
-   double prev = -LZERO;
-   double obj;
+   int t, i, l;
+   const int n = end - start;
+   double *buff, *step, *prev, *obj;
+   double *pt;
+   const double *gt;
 
    if (pst->gv_length == 0)
       return;
 
-   HTS_PStream_conv_gv(pst, m);
+   /* mean, vari, dv, gvobj, step, prev and obj of each dimension */
+   buff = (double *) HTS_calloc(7 * n, sizeof(double));
+   step = buff + 4 * n;
+   prev = buff + 5 * n;
+   obj = buff + 6 * n;
+
+   HTS_PStream_conv_gv(pst, start, end, buff, buff + n);
    if (GV_MAX_ITERATION > 0) {
-      HTS_PStream_calc_wuw_and_wum(pst, m);
+      HTS_PStream_calc_wuw_and_wum(pst, start, end, 0, pst->length);
+      for (l = 0; l < n; l++) {
+         step[l] = STEPINIT;
+         prev[l] = -LZERO;
+      }
       for (i = 1; i <= GV_MAX_ITERATION; i++) {
-         obj = HTS_PStream_calc_derivative(pst, m);
-         if (obj > prev)
-            step *= STEPDEC;
-         if (obj < prev)
-            step *= STEPINC;
-         for (t = 0; t < pst->length; t++)
-            pst->par[t][m] += step * pst->sm.g[t];
-         prev = obj;
+         HTS_PStream_calc_derivative(pst, start, end, buff, obj);
+         for (l = 0; l < n; l++) {
+            if (obj[l] > prev[l])
+               step[l] *= STEPDEC;
+            if (obj[l] < prev[l])
+               step[l] *= STEPINC;
+         }
+         for (t = 0; t < pst->length; t++) {
+            pt = pst->par[t] + start;
+            gt = pst->sm.g + t * n;
+            for (l = 0; l < n; l++)
+               pt[l] += step[l] * gt[l];
+         }
+         for (l = 0; l < n; l++)
+            prev[l] = obj[l];
       }
    }
+
+   HTS_free(buff);
+}
+
+/* HTS_PStream_mlpg_range: mlpg for static dimensions from start to end - 1 */
+static void HTS_PStream_mlpg_range(HTS_PStream * pst, const int start, const int end)
+{
+   HTS_PStream_calc_wuw_and_wum(pst, start, end, 0, pst->length);
+   HTS_PStream_ldl_factorization(pst, start, end, 0, pst->length);      /* LDL factorization */
+   HTS_PStream_forward_substitution(pst, start, end, 0, pst->length);   /* forward substitution   */
+   HTS_PStream_backward_substitution(pst, start, end, 0, pst->length);  /* backward substitution  */
+   if (pst->gv_length > 0)
+      HTS_PStream_gv_parmgen(pst, start, end);
+}
+
+#ifdef HAVE_PTHREAD_H
+/* HTS_PStreamWorker: range of static dimensions solved by one thread */
+typedef struct _HTS_PStreamWorker {
+   HTS_PStream pst;             /* copy of the stream with its own matrices */
+   int start;                   /* first static dimension */
+   int end;                     /* last static dimension + 1 */
+   pthread_t thread;            /* thread handle */
+   HTS_Boolean running;         /* thread was started */
+} HTS_PStreamWorker;
+
+/* HTS_PStreamWorker_run: thread entry of HTS_PStreamWorker */
+static void *HTS_PStreamWorker_run(void *arg)
+{
+   HTS_PStreamWorker *w = (HTS_PStreamWorker *) arg;
+
+   HTS_PStream_mlpg_range(&w->pst, w->start, w->end);
+   return NULL;
 }
+#endif                          /* HAVE_PTHREAD_H */
 
 /* HTS_PStream_mlpg: generate sequence of speech parameter vector maximizing its output probability for given pdf sequence */
-static void HTS_PStream_mlpg(HTS_PStream * pst)
+static void HTS_PStream_mlpg(HTS_PStream * pst, int num_threads)
 {
-   int m;
+#ifdef HAVE_PTHREAD_H
+   int i, n;
+   HTS_PStreamWorker *worker;
+#endif                          /* HAVE_PTHREAD_H */
 
    if (pst->length == 0)
       return;
 
-   for (m = 0; m < pst->static_length; m++) {
-      HTS_PStream_calc_wuw_and_wum(pst, m);
-      HTS_PStream_ldl_factorization(pst);       /* LDL factorization */
-      HTS_PStream_forward_substitution(pst);    /* forward substitution   */
-      HTS_PStream_backward_substitution(pst, m);        /* backward substitution  */
-      if (pst->gv_length > 0)
-         HTS_PStream_gv_parmgen(pst, m);
+#ifdef HAVE_PTHREAD_H
+   /* static dimensions are independent; each thread solves a contiguous
+      range with its own W'U^{-1}W, W'U^{-1}M and g, and writes disjoint
+      columns of par, so the result does not depend on num_threads */
+   if (num_threads > pst->static_length)
+      num_threads = pst->static_length;
+   if (num_threads > pst->length * pst->static_length / MIN_WORK_PER_THREAD)
+      num_threads = pst->length * pst->static_length / MIN_WORK_PER_THREAD;
+   if (num_threads > 1) {
+      worker = (HTS_PStreamWorker *) HTS_calloc(num_threads, sizeof(HTS_PStreamWorker));
+      for (i = 0; i < num_threads; i++) {
+         worker[i].pst = *pst;
+         worker[i].start = pst->static_length * i / num_threads;
+         worker[i].end = pst->static_length * (i + 1) / num_threads;
+         if (i > 0) {
+            n = worker[i].end - worker[i].start;
+            worker[i].pst.sm.wum = (double *) HTS_calloc(pst->length * n, sizeof(double));
+            worker[i].pst.sm.wuw = (double *) HTS_calloc(pst->length * pst->width * n, sizeof(double));
+            worker[i].pst.sm.g = (double *) HTS_calloc(pst->length * n, sizeof(double));
+            worker[i].running =
+                pthread_create(&worker[i].thread, NULL, HTS_PStreamWorker_run, &worker[i]) == 0;
+         }
+      }
+      HTS_PStream_mlpg_range(pst, worker[0].start, worker[0].end);
+      for (i = 1; i < num_threads; i++) {
+         if (worker[i].running)
+            pthread_join(worker[i].thread, NULL);
+         else
+            HTS_PStream_mlpg_range(&worker[i].pst, worker[i].start, worker[i].end);
+         HTS_free(worker[i].pst.sm.wum);
+         HTS_free(worker[i].pst.sm.wuw);
+         HTS_free(worker[i].pst.sm.g);
+      }
+      HTS_free(worker);
+      return;
+   }
+#endif                          /* HAVE_PTHREAD_H */
+
+   HTS_PStream_mlpg_range(pst, 0, pst->static_length);
+}
+
+/* HTS_PStream_conv_gv_incremental: subfunction for incremental mlpg using GV */
+static void HTS_PStream_conv_gv_incremental(HTS_PStream * pst, const int start, const int end, const int to)
+{
+   int t, l;
+   const int n = pst->static_length;
+   double *mean, *ratio;
+   double *pt;
+   const double *mt;
+
+   /* gv_sum and gv_sqr hold the statistics of the whole utterance where
+      frames not generated yet are represented by their static means; the
+      final frames replace their means here and the look-ahead frames from
+      end to to - 1 replace theirs for this estimate only. The final frames
+      are scaled like HTS_PStream_conv_gv without the gradient iterations of
+      HTS_PStream_gv_parmgen. */
+   for (t = start; t < end; t++)
+      if (pst->gv_switch[t]) {
+         pt = pst->par[t];
+         mt = pst->sm.mean[t];
+         for (l = 0; l < n; l++) {
+            pst->gv_sum[l] += pt[l] - mt[l];
+            pst->gv_sqr[l] += pt[l] * pt[l] - mt[l] * mt[l];
+         }
+      }
+
+   mean = (double *) HTS_calloc(2 * n, sizeof(double));
+   ratio = mean + n;
+   for (l = 0; l < n; l++) {
+      mean[l] = pst->gv_sum[l];
+      ratio[l] = pst->gv_sqr[l];
+   }
+   for (t = end; t < to; t++)
+      if (pst->gv_switch[t]) {
+         pt = pst->par[t];
+         mt = pst->sm.mean[t];
+         for (l = 0; l < n; l++) {
+            mean[l] += pt[l] - mt[l];
+            ratio[l] += pt[l] * pt[l] - mt[l] * mt[l];
+         }
+      }
+
+   for (l = 0; l < n; l++) {
+      mean[l] /= pst->gv_length;
+      ratio[l] = ratio[l] / pst->gv_length - mean[l] * mean[l];
+      ratio[l] = ratio[l] > 0.0 ? sqrt(pst->gv_mean[l] / ratio[l]) : 1.0;
+   }
+   for (t = start; t < end; t++)
+      if (pst->gv_switch[t]) {
+         pt = pst->par[t];
+         for (l = 0; l < n; l++)
+            pt[l] = ratio[l] * (pt[l] - mean[l]) + mean[l];
+      }
+
+   HTS_free(mean);
+}
+
+/* HTS_PStream_mlpg_incremental: make the next lookahead frames final using lookahead frames after them */
+static void HTS_PStream_mlpg_incremental(HTS_PStream * pst, const int lookahead)
+{
+   int t, l;
+   const int start = pst->final_length;
+   const int end = start + lookahead < pst->length ? start + lookahead : pst->length;
+   const int to = end + lookahead < pst->length ? end + lookahead : pst->length;
+
+   /* exact up to frame to - 1 */
+   if (pst->forward_length < to) {
+      HTS_PStream_calc_wuw_and_wum(pst, 0, pst->static_length, pst->forward_length, to);
+      HTS_PStream_ldl_factorization(pst, 0, pst->static_length, pst->forward_length, to);
+      HTS_PStream_forward_substitution(pst, 0, pst->static_length, pst->forward_length, to);
+      pst->forward_length = to;
    }
+   /* frames after the look-ahead are approximated by their static means */
+   for (t = to; t < to + pst->width - 1 && t < pst->length; t++)
+      for (l = 0; l < pst->static_length; l++)
+         pst->par[t][l] = pst->sm.mean[t][l];
+   HTS_PStream_backward_substitution(pst, 0, pst->static_length, start, to);
+   if (pst->gv_length > 0)
+      HTS_PStream_conv_gv_incremental(pst, start, end, to);
+   pst->final_length = end;
+}
+
+/* HTS_PStream_finalize: make parameters up to frame final (for incremental generation) */
+static void HTS_PStream_finalize(HTS_PStream * pst, const int lookahead, const int frame)
+{
+   while (pst->final_length <= frame && pst->final_length < pst->length)
+      HTS_PStream_mlpg_incremental(pst, lookahead);
 }
 
 /* HTS_PStreamSet_initialize: initialize parameter stream set */
@@ -265,10 +537,12 @@ void HTS_PStreamSet_initialize(HTS_PStreamSet * pss)
    pss->pstream = NULL;
    pss->nstream = 0;
    pss->total_frame = 0;
+   pss->lookahead = 0;
+   pss->request_frame = 0;
 }
 
-/* HTS_PStreamSet_create: parameter generation using GV weight */
-HTS_Boolean HTS_PStreamSet_create(HTS_PStreamSet * pss, HTS_SStreamSet * sss, double *msd_threshold, double *gv_weight)
+/* HTS_PStreamSet_create_pstream: subfunction of HTS_PStreamSet_create and HTS_PStreamSet_create_incremental */
+static HTS_Boolean HTS_PStreamSet_create_pstream(HTS_PStreamSet * pss, HTS_SStreamSet * sss, double *msd_threshold, double *gv_weight, int num_threads, int lookahead)
 {
    int i, j, k, l, m;
    int frame, msd_frame, state;
@@ -285,6 +559,8 @@ HTS_Boolean HTS_PStreamSet_create(HTS_PStreamSet * pss, HTS_SStreamSet * sss, do
    pss->nstream = HTS_SStreamSet_get_nstream(sss);
    pss->pstream = (HTS_PStream *) HTS_calloc(pss->nstream, sizeof(HTS_PStream));
    pss->total_frame = HTS_SStreamSet_get_total_frame(sss);
+   pss->lookahead = lookahead > 0 ? lookahead : 0;
+   pss->request_frame = 0;
 
    /* create */
    for (i = 0; i < pss->nstream; i++) {
@@ -315,9 +591,9 @@ HTS_Boolean HTS_PStreamSet_create(HTS_PStreamSet * pss, HTS_SStreamSet * sss, do
       pst->static_length = pst->vector_length / pst->win_size;
       pst->sm.mean = HTS_alloc_matrix(pst->length, pst->vector_length);
       pst->sm.ivar = HTS_alloc_matrix(pst->length, pst->vector_length);
-      pst->sm.wum = (double *) HTS_calloc(pst->length, sizeof(double));
-      pst->sm.wuw = HTS_alloc_matrix(pst->length, pst->width);
-      pst->sm.g = (double *) HTS_calloc(pst->length, sizeof(double));
+      pst->sm.wum = (double *) HTS_calloc(pst->length * pst->static_length, sizeof(double));
+      pst->sm.wuw = (double *) HTS_calloc(pst->length * pst->width * pst->static_length, sizeof(double));
+      pst->sm.g = (double *) HTS_calloc(pst->length * pst->static_length, sizeof(double));
       pst->par = HTS_alloc_matrix(pst->length, pst->static_length);
       /* copy dynamic window */
       pst->win_l_width = (int *) HTS_calloc(pst->win_size, sizeof(int));
@@ -414,12 +690,77 @@ HTS_Boolean HTS_PStreamSet_create(HTS_PStreamSet * pss, HTS_SStreamSet * sss, do
          }
       }
       /* parameter generation */
-      HTS_PStream_mlpg(pst);
+      pst->request_length = 0;
+      pst->forward_length = 0;
+      pst->gv_sum = NULL;
+      pst->gv_sqr = NULL;
+      if (pss->lookahead > 0 && 2 * pss->lookahead < pst->length) {
+         /* incremental: frames are made final by HTS_PStreamSet_generate */
+         pst->final_length = 0;
+         if (pst->gv_length > 0) {
+            pst->gv_sum = (double *) HTS_calloc(pst->static_length, sizeof(double));
+            pst->gv_sqr = (double *) HTS_calloc(pst->static_length, sizeof(double));
+            for (j = 0; j < pst->length; j++)
+               if (pst->gv_switch[j])
+                  for (l = 0; l < pst->static_length; l++) {
+                     pst->gv_sum[l] += pst->sm.mean[j][l];
+                     pst->gv_sqr[l] += pst->sm.mean[j][l] * pst->sm.mean[j][l];
+                  }
+         }
+      } else {
+         HTS_PStream_mlpg(pst, num_threads);
+         pst->final_length = pst->length;
+      }
    }
 
    return TRUE;
 }
 
+/* HTS_PStreamSet_create: parameter generation using GV weight */
+HTS_Boolean HTS_PStreamSet_create(HTS_PStreamSet * pss, HTS_SStreamSet * sss, double *msd_threshold, double *gv_weight)
+{
+   return HTS_PStreamSet_create_pstream(pss, sss, msd_threshold, gv_weight, 1, 0);
+}
+
+/* HTS_PStreamSet_create_with_threads: parameter generation using GV weight on up to num_threads threads */
+HTS_Boolean HTS_PStreamSet_create_with_threads(HTS_PStreamSet * pss, HTS_SStreamSet * sss, double *msd_threshold, double *gv_weight, int num_threads)
+{
+   return HTS_PStreamSet_create_pstream(pss, sss, msd_threshold, gv_weight, num_threads, 0);
+}
+
+/* HTS_PStreamSet_create_incremental: parameter generation with look-ahead frames (generated on one thread) */
+HTS_Boolean HTS_PStreamSet_create_incremental(HTS_PStreamSet * pss, HTS_SStreamSet * sss, double *msd_threshold, double *gv_weight, int lookahead)
+{
+   return HTS_PStreamSet_create_pstream(pss, sss, msd_threshold, gv_weight, 1, lookahead);
+}
+
+/* HTS_PStreamSet_generate: make parameters of the first total_frame frames final (for incremental generation) */
+void HTS_PStreamSet_generate(HTS_PStreamSet * pss, int total_frame)
+{
+   int i, j;
+   HTS_PStream *pst;
+
+   if (total_frame > pss->total_frame)
+      total_frame = pss->total_frame;
+   if (pss->lookahead == 0 || total_frame <= pss->request_frame)
+      return;
+
+   for (i = 0; i < pss->nstream; i++) {
+      pst = &pss->pstream[i];
+      if (pst->final_length == pst->length)
+         continue;
+      if (pst->msd_flag) {      /* for MSD */
+         for (j = pss->request_frame; j < total_frame; j++)
+            if (pst->msd_flag[j])
+               pst->request_length++;
+      } else {                  /* for non MSD */
+         pst->request_length = total_frame;
+      }
+      HTS_PStream_finalize(pst, pss->lookahead, pst->request_length - 1);
+   }
+   pss->request_frame = total_frame;
+}
+
 /* HTS_PStreamSet_get_nstream: get number of stream */
 int HTS_PStreamSet_get_nstream(HTS_PStreamSet * pss)
 {
@@ -438,15 +779,17 @@ int HTS_PStreamSet_get_total_frame(HTS_PStreamSet * pss)
    return pss->total_frame;
 }
 
-/* HTS_PStreamSet_get_parameter: get parameter */
+/* HTS_PStreamSet_get_parameter: get parameter (frames which are not final yet are generated first) */
 double HTS_PStreamSet_get_parameter(HTS_PStreamSet * pss, int stream_index, int frame_index, int vector_index)
 {
+   HTS_PStream_finalize(&pss->pstream[stream_index], pss->lookahead, frame_index);
    return pss->pstream[stream_index].par[frame_index][vector_index];
 }
 
-/* HTS_PStreamSet_get_parameter_vector: get parameter vector*/
+/* HTS_PStreamSet_get_parameter_vector: get parameter vector (frames which are not final yet are generated first) */
 double *HTS_PStreamSet_get_parameter_vector(HTS_PStreamSet * pss, int stream_index, int frame_index)
 {
+   HTS_PStream_finalize(&pss->pstream[stream_index], pss->lookahead, frame_index);
    return pss->pstream[stream_index].par[frame_index];
 }
 
@@ -473,7 +816,7 @@ void HTS_PStreamSet_clear(HTS_PStreamSet * pss)
          pstream = &pss->pstream[i];
          HTS_free(pstream->sm.wum);
          HTS_free(pstream->sm.g);
-         HTS_free_matrix(pstream->sm.wuw, pstream->length);
+         HTS_free(pstream->sm.wuw);
          HTS_free_matrix(pstream->sm.ivar, pstream->length);
          HTS_free_matrix(pstream->sm.mean, pstream->length);
          HTS_free_matrix(pstream->par, pstream->length);
@@ -487,6 +830,10 @@ void HTS_PStreamSet_clear(HTS_PStreamSet * pss)
             HTS_free(pstream->gv_mean);
          if (pstream->gv_vari)
             HTS_free(pstream->gv_vari);
+         if (pstream->gv_sum)
+            HTS_free(pstream->gv_sum);
+         if (pstream->gv_sqr)
+            HTS_free(pstream->gv_sqr);
          HTS_free(pstream->win_coefficient);
          HTS_free(pstream->win_l_width);
          HTS_free(pstream->win_r_width);
@@ -100,27 +100,6 @@ static void HTS_movem(double *a, double *b, const int nitem)
    }
 }
 
-/* HTS_mlsafir: sub functions for MLSA filter */
-static double HTS_mlsafir(const double x, const double *b, const int m, const double a, const double aa, double *d)
-{
-   double y = 0.0;
-   int i;
-
-   d[0] = x;
-   d[1] = aa * d[0] + a * d[1];
-
-   for (i = 2; i <= m; i++)
-      d[i] += a * (d[i + 1] - d[i - 1]);
-
-   for (i = 2; i <= m; i++)
-      y += d[i] * b[i];
-
-   for (i = m + 1; i > 1; i--)
-      d[i] = d[i - 1];
-
-   return (y);
-}
-
 /* HTS_mlsadf1: sub functions for MLSA filter */
 static double HTS_mlsadf1(double x, const double *b, const int m, const double a, const double aa, const int pd, double *d, const double *ppade)
 {
@@ -146,13 +125,37 @@ static double HTS_mlsadf1(double x, const double *b, const int m, const double a
 /* HTS_mlsadf2: sub functions for MLSA filter */
 static double HTS_mlsadf2(double x, const double *b, const int m, const double a, const double aa, const int pd, double *d, const double *ppade)
 {
-   double v, out = 0.0, *pt;
-   int i;
+   double v, out = 0.0, *pt, *dj;
+   double y[PADEORDER], prev[PADEORDER], cur;
+   int i, j, s;
 
    pt = &d[pd * (m + 2)];
 
+   /* each stage filters the output of the stage below at the previous
+      sample, so all stages are independent within a sample and are run in
+      lockstep: d[j * pd + s] is the j-th delay of stage s + 1, and the
+      update, the output sum and the shift of the delays are done in one
+      pass over j with the innermost loop running over the stages */
+   for (s = 0; s < pd; s++) {
+      d[s] = pt[s];
+      d[pd + s] = aa * d[s] + a * d[pd + s];
+      prev[s] = d[pd + s];
+      y[s] = 0.0;
+   }
+   for (j = 2; j <= m; j++) {
+      dj = &d[j * pd];
+      for (s = 0; s < pd; s++) {
+         cur = dj[s] + a * (dj[pd + s] - prev[s]);
+         y[s] += cur * b[j];
+         dj[s] = prev[s];
+         prev[s] = cur;
+      }
+   }
+   for (s = 0; s < pd; s++)
+      d[(m + 1) * pd + s] = prev[s];
+
    for (i = pd; i >= 1; i--) {
-      pt[i] = HTS_mlsafir(pt[i - 1], b, m, a, aa, &d[(i - 1) * (m + 2)]);
+      pt[i] = y[i - 1];
       v = pt[i] * ppade[i];
 
       x += (1 & i) ? v : -v;
@@ -743,6 +746,7 @@ void HTS_Vocoder_initialize(HTS_Vocoder * v, const int m, const int stage, HTS_B
       v->d1 = v->cinc + m + 1;
    }
    v->pulse_list = (double *) HTS_calloc(PULSELISTSIZE, sizeof(double));
+   v->excite_buff = (double *) HTS_calloc(fperiod, sizeof(double));
 }
 
 /* HTS_Vocoder_synthesize: pulse/noise excitation and MLSA/MGLSA filster based waveform synthesis */
@@ -753,6 +757,9 @@ void HTS_Vocoder_synthesize(HTS_Vocoder * v, const int m, double lf0, double *sp
    short xs;
    int rawidx = 0;
    double p;
+   double gain = 0.0;
+   HTS_Boolean gain_valid = FALSE;
+   double *e = v->excite_buff;
 
    /* lf0 -> pitch */
    if (lf0 == LZERO)
@@ -798,20 +805,48 @@ void HTS_Vocoder_synthesize(HTS_Vocoder * v, const int m, double lf0, double *sp
          v->cinc[i] = (v->cc[i] - v->c[i]) * v->iprd / v->fprd;
    }
 
+   /* excitation of the whole frame */
    for (j = 0, i = (v->iprd + 1) / 2; j < v->fprd; j++) {
-      x = HTS_Vocoder_get_excitation(v, j, i, nlpf, lpf);
-      if (v->stage == 0) {      /* for MCP */
-         if (x != 0.0)
-            x *= exp(v->c[0]);
-         x = HTS_mlsadf(x, v->c, m, alpha, PADEORDER, v->d1);
-      } else {                  /* for LSP */
+      e[j] = HTS_Vocoder_get_excitation(v, j, i, nlpf, lpf);
+      if (!--i)
+         i = v->iprd;
+   }
+
+   /* filtering; the filter coefficients are interpolated every iprd samples */
+   if (v->stage == 0) {         /* for MCP */
+      for (j = 0, i = (v->iprd + 1) / 2; j < v->fprd; j++) {
+         if (e[j] != 0.0) {
+            /* gain is only calculated once per coefficient update */
+            if (!gain_valid) {
+               gain = exp(v->c[0]);
+               gain_valid = TRUE;
+            }
+            e[j] *= gain;
+         }
+         e[j] = HTS_mlsadf(e[j], v->c, m, alpha, PADEORDER, v->d1) * volume;
+         if (!--i) {
+            for (i = 0; i <= m; i++)
+               v->c[i] += v->cinc[i];
+            i = v->iprd;
+            gain_valid = FALSE;
+         }
+      }
+   } else {                     /* for LSP */
+      for (j = 0, i = (v->iprd + 1) / 2; j < v->fprd; j++) {
          if (!NGAIN)
-            x *= v->c[0];
-         x = HTS_mglsadf(x, v->c, m, alpha, v->stage, v->d1);
+            e[j] *= v->c[0];
+         e[j] = HTS_mglsadf(e[j], v->c, m, alpha, v->stage, v->d1) * volume;
+         if (!--i) {
+            for (i = 0; i <= m; i++)
+               v->c[i] += v->cinc[i];
+            i = v->iprd;
+         }
       }
-      x *= volume;
+   }
 
-      /* output */
+   /* output */
+   for (j = 0; j < v->fprd; j++) {
+      x = e[j];
       if (x > 32767.0)
          xs = 32767;
       else if (x < -32768.0)
@@ -822,12 +857,6 @@ void HTS_Vocoder_synthesize(HTS_Vocoder * v, const int m, double lf0, double *sp
          rawdata[rawidx++] = xs;
       if (audio)
          HTS_Audio_write(audio, xs);
-
-      if (!--i) {
-         for (i = 0; i <= m; i++)
-            v->c[i] += v->cinc[i];
-         i = v->iprd;
-      }
    }
 
    HTS_Vocoder_end_excitation(v, nlpf);
@@ -896,6 +925,8 @@ void HTS_Vocoder_clear(HTS_Vocoder * v)
       }
       if (v->pulse_list != NULL)
          HTS_free(v->pulse_list);
+      if (v->excite_buff != NULL)
+         HTS_free(v->excite_buff);
    }
 }
 
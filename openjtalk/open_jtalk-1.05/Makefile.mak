@@ -32,6 +32,9 @@ all:
 	cd njd_set_long_vowel
 	nmake /f Makefile.mak
 	cd ..
+	cd njd_set_accent_and_vowel
+	nmake /f Makefile.mak
+	cd ..
 	cd njd2jpcommon
 	nmake /f Makefile.mak
 	cd ..
@@ -76,6 +79,9 @@ clean:
 	cd njd_set_long_vowel
 	nmake /f Makefile.mak clean
 	cd ..
+	cd njd_set_accent_and_vowel
+	nmake /f Makefile.mak clean
+	cd ..
 	cd njd2jpcommon
 	nmake /f Makefile.mak clean
 	cd ..
@@ -0,0 +1,271 @@
+/* ----------------------------------------------------------------- */
+/*           The Japanese TTS System "Open JTalk"                    */
+/*           developed by HTS Working Group                          */
+/*           http://open-jtalk.sourceforge.net/                      */
+/* ----------------------------------------------------------------- */
+/*                                                                   */
+/*  Copyright (c) 2008-2011  Nagoya Institute of Technology          */
+/*                           Department of Computer Science          */
+/*                                                                   */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/* - Redistributions of source code must retain the above copyright  */
+/*   notice, this list of conditions and the following disclaimer.   */
+/* - Redistributions in binary form must reproduce the above         */
+/*   copyright notice, this list of conditions and the following     */
+/*   disclaimer in the documentation and/or other materials provided */
+/*   with the distribution.                                          */
+/* - Neither the name of the HTS working group nor the names of its  */
+/*   contributors may be used to endorse or promote products derived */
+/*   from this software without specific prior written permission.   */
+/*                                                                   */
+/* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND            */
+/* CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,       */
+/* INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF          */
+/* MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE          */
+/* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS */
+/* BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,          */
+/* EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED   */
+/* TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,     */
+/* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON */
+/* ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,   */
+/* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY    */
+/* OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE           */
+/* POSSIBILITY OF SUCH DAMAGE.                                       */
+/* ----------------------------------------------------------------- */
+
+/* Runs the front end of Open JTalk (text2mecab through JPCommon_make_label) over every line of
+   a text file and reports the time spent in each stage and, with glibc, the number of heap
+   allocations per pass. The NJD passes are called one by one so that each gets its own time. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "mecab.h"
+#include "njd.h"
+#include "jpcommon.h"
+#include "text2mecab.h"
+#include "mecab2njd.h"
+#include "njd_set_pronunciation.h"
+#include "njd_set_digit.h"
+#include "njd_set_accent_phrase.h"
+#include "njd_set_accent_type.h"
+#include "njd_set_unvoiced_vowel.h"
+#include "njd_set_long_vowel.h"
+#include "njd2jpcommon.h"
+
+#define MAXBUFLEN 1024
+
+#if defined(__GLIBC__)
+/* count every heap allocation of the process, including those of libstdc++ */
+extern void *__libc_malloc(size_t size);
+extern void *__libc_calloc(size_t num, size_t size);
+extern void *__libc_realloc(void *ptr, size_t size);
+
+static unsigned long num_allocations = 0;
+
+void *malloc(size_t size)
+{
+   num_allocations++;
+   return __libc_malloc(size);
+}
+
+void *calloc(size_t num, size_t size)
+{
+   num_allocations++;
+   return __libc_calloc(num, size);
+}
+
+void *realloc(void *ptr, size_t size)
+{
+   num_allocations++;
+   return __libc_realloc(ptr, size);
+}
+#endif                          /* __GLIBC__ */
+
+enum {
+   STAGE_TEXT2MECAB,
+   STAGE_MECAB,
+   STAGE_MECAB2NJD,
+   STAGE_PRONUNCIATION,
+   STAGE_DIGIT,
+   STAGE_ACCENT_PHRASE,
+   STAGE_ACCENT_TYPE,
+   STAGE_UNVOICED_VOWEL,
+   STAGE_LONG_VOWEL,
+   STAGE_NJD2JPCOMMON,
+   STAGE_MAKE_LABEL,
+   STAGE_REFRESH,
+   NUM_STAGES
+};
+
+static const char *stage_name[NUM_STAGES] = {
+   "text2mecab",
+   "Mecab_analysis",
+   "mecab2njd",
+   "njd_set_pronunciation",
+   "njd_set_digit",
+   "njd_set_accent_phrase",
+   "njd_set_accent_type",
+   "njd_set_unvoiced_vowel",
+   "njd_set_long_vowel",
+   "njd2jpcommon",
+   "JPCommon_make_label",
+   "refresh"
+};
+
+static double get_time(void)
+{
+#if defined(CLOCK_MONOTONIC)
+   struct timespec ts;
+
+   clock_gettime(CLOCK_MONOTONIC, &ts);
+   return ts.tv_sec + ts.tv_nsec * 1e-9;
+#else
+   return (double) clock() / CLOCKS_PER_SEC;
+#endif                          /* CLOCK_MONOTONIC */
+}
+
+/* run all stages on one line and add the time of each stage to 'sec' */
+static void analysis(Mecab * mecab, NJD * njd, JPCommon * jpcommon, const char *txt, double *sec)
+{
+   char buff[MAXBUFLEN * 4];
+   double t[NUM_STAGES + 1];
+   int i;
+
+   t[0] = get_time();
+   text2mecab(buff, txt);
+   t[1] = get_time();
+   Mecab_analysis(mecab, buff);
+   t[2] = get_time();
+   mecab2njd_from_node(njd, Mecab_get_node(mecab));
+   t[3] = get_time();
+   njd_set_pronunciation(njd);
+   t[4] = get_time();
+   njd_set_digit(njd);
+   t[5] = get_time();
+   njd_set_accent_phrase(njd);
+   t[6] = get_time();
+   njd_set_accent_type(njd);
+   t[7] = get_time();
+   njd_set_unvoiced_vowel(njd);
+   t[8] = get_time();
+   njd_set_long_vowel(njd);
+   t[9] = get_time();
+   njd2jpcommon(jpcommon, njd);
+   t[10] = get_time();
+   JPCommon_make_label(jpcommon);
+   t[11] = get_time();
+   JPCommon_refresh(jpcommon);
+   NJD_refresh(njd);
+   Mecab_refresh(mecab);
+   t[12] = get_time();
+
+   for (i = 0; i < NUM_STAGES; i++)
+      sec[i] += t[i + 1] - t[i];
+}
+
+static void usage(void)
+{
+   fprintf(stderr, "usage: frontend_bench [-n passes] dicdir textfile\n");
+   exit(1);
+}
+
+int main(int argc, char **argv)
+{
+   Mecab mecab;
+   NJD njd;
+   JPCommon jpcommon;
+   FILE *fp;
+   char buff[MAXBUFLEN];
+   char **line = NULL;
+   int num_lines = 0;
+   int max_lines = 0;
+   long num_bytes = 0;
+   int num_passes = 5;
+   double sec[NUM_STAGES];
+   double total = 0.0;
+   unsigned long allocations[2] = { 0, 0 };
+   int i, j;
+
+   for (i = 1; i < argc && argv[i][0] == '-'; i++) {
+      if (strcmp(argv[i], "-n") == 0 && i + 1 < argc)
+         num_passes = atoi(argv[++i]);
+      else
+         usage();
+   }
+   if (argc - i != 2 || num_passes < 1)
+      usage();
+
+   if ((fp = fopen(argv[i + 1], "r")) == NULL) {
+      fprintf(stderr, "ERROR: Cannot open %s.\n", argv[i + 1]);
+      return 1;
+   }
+   while (fgets(buff, MAXBUFLEN, fp) != NULL) {
+      buff[strcspn(buff, "\r\n")] = '\0';
+      if (buff[0] == '\0')
+         continue;
+      if (num_lines == max_lines) {
+         max_lines = max_lines ? max_lines * 2 : 1024;
+         line = (char **) realloc(line, max_lines * sizeof(char *));
+      }
+      line[num_lines] = (char *) malloc(strlen(buff) + 1);
+      strcpy(line[num_lines++], buff);
+      num_bytes += strlen(buff);
+   }
+   fclose(fp);
+   if (num_lines == 0) {
+      fprintf(stderr, "ERROR: %s has no text.\n", argv[i + 1]);
+      return 1;
+   }
+
+   Mecab_initialize(&mecab);
+   NJD_initialize(&njd);
+   JPCommon_initialize(&jpcommon);
+   Mecab_load(&mecab, argv[i]);
+
+   /* the first pass also builds the tables of each module and is not timed */
+   for (j = 0; j < NUM_STAGES; j++)
+      sec[j] = 0.0;
+   for (j = 0; j < num_lines; j++)
+      analysis(&mecab, &njd, &jpcommon, line[j], sec);
+   for (j = 0; j < NUM_STAGES; j++)
+      sec[j] = 0.0;
+#if defined(__GLIBC__)
+   allocations[0] = num_allocations;
+#endif                          /* __GLIBC__ */
+   for (i = 0; i < num_passes; i++)
+      for (j = 0; j < num_lines; j++)
+         analysis(&mecab, &njd, &jpcommon, line[j], sec);
+#if defined(__GLIBC__)
+   allocations[1] = num_allocations;
+#endif                          /* __GLIBC__ */
+
+   printf("%d lines, %ld bytes, %d passes\n", num_lines, num_bytes, num_passes);
+   printf("%-24s %10s %10s\n", "stage", "ms/pass", "ns/byte");
+   for (j = 0; j < NUM_STAGES; j++) {
+      printf("%-24s %10.3f %10.1f\n", stage_name[j], sec[j] * 1e3 / num_passes,
+             sec[j] * 1e9 / num_passes / num_bytes);
+      total += sec[j];
+   }
+   printf("%-24s %10.3f %10.1f\n", "total", total * 1e3 / num_passes,
+          total * 1e9 / num_passes / num_bytes);
+#if defined(__GLIBC__)
+   printf("allocations per pass: %lu\n", (allocations[1] - allocations[0]) / num_passes);
+#endif                          /* __GLIBC__ */
+
+   Mecab_clear(&mecab);
+   NJD_clear(&njd);
+   JPCommon_clear(&jpcommon);
+   for (j = 0; j < num_lines; j++)
+      free(line[j]);
+   free(line);
+
+   return 0;
+}
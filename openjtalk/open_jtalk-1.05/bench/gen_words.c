@@ -0,0 +1,131 @@
+/* ----------------------------------------------------------------- */
+/*           The Japanese TTS System "Open JTalk"                    */
+/*           developed by HTS Working Group                          */
+/*           http://open-jtalk.sourceforge.net/                      */
+/* ----------------------------------------------------------------- */
+/*                                                                   */
+/*  Copyright (c) 2008-2011  Nagoya Institute of Technology          */
+/*                           Department of Computer Science          */
+/*                                                                   */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/* - Redistributions of source code must retain the above copyright  */
+/*   notice, this list of conditions and the following disclaimer.   */
+/* - Redistributions in binary form must reproduce the above         */
+/*   copyright notice, this list of conditions and the following     */
+/*   disclaimer in the documentation and/or other materials provided */
+/*   with the distribution.                                          */
+/* - Neither the name of the HTS working group nor the names of its  */
+/*   contributors may be used to endorse or promote products derived */
+/*   from this software without specific prior written permission.   */
+/*                                                                   */
+/* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND            */
+/* CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,       */
+/* INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF          */
+/* MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE          */
+/* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS */
+/* BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,          */
+/* EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED   */
+/* TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,     */
+/* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON */
+/* ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,   */
+/* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY    */
+/* OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE           */
+/* POSSIBILITY OF SUCH DAMAGE.                                       */
+/* ----------------------------------------------------------------- */
+
+/* Writes a large noun dictionary in the CSV format of mecab-naist-jdic, or a text made of its
+   words, to stdout in EUC-JP. Surfaces are 2 to 6 random JIS level 1 kanji; entry i depends only
+   on i, so the text and the dictionary agree for the same number of entries. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MINLEN 2
+#define MAXLEN 6
+
+/* "名詞,一般" and "ア" in EUC-JP */
+#define NOUN_EUC_JP "\xcc\xbe\xbb\xec,\xb0\xec\xc8\xcc"
+#define PRON_EUC_JP "\xa5\xa2"
+
+static unsigned long hash(unsigned long x)
+{
+   x = ((x >> 16) ^ x) * 0x45d9f3bUL;
+   x = ((x >> 16) ^ x) * 0x45d9f3bUL;
+   return ((x >> 16) ^ x) & 0xffffffffUL;
+}
+
+/* linear congruential generator, the same sequence on every platform */
+static unsigned long next_random(unsigned long *seed)
+{
+   *seed = (*seed * 1103515245UL + 12345UL) & 0x7fffffffUL;
+   return *seed >> 16;
+}
+
+static void get_word(unsigned long id, char *buff)
+{
+   unsigned long seed = hash(id + 1);
+   int i, len;
+
+   len = MINLEN + next_random(&seed) % (MAXLEN - MINLEN + 1);
+   for (i = 0; i < len; i++) {
+      /* rows 0xb0-0xce and cells 0xa1-0xfe of EUC-JP are all level 1 kanji */
+      buff[i * 2] = (char) (0xb0 + next_random(&seed) % 31);
+      buff[i * 2 + 1] = (char) (0xa1 + next_random(&seed) % 94);
+   }
+   buff[len * 2] = '\0';
+}
+
+static void usage(void)
+{
+   fprintf(stderr, "usage: gen_words [-t lines] entries\n");
+   fprintf(stderr, "  without -t, print the dictionary entries as CSV\n");
+   fprintf(stderr, "  with -t, print lines of 4 to 10 random words of the dictionary\n");
+   exit(1);
+}
+
+int main(int argc, char **argv)
+{
+   char buff[MAXLEN * 2 + 1];
+   long num_lines = -1;
+   long num_entries;
+   unsigned long seed = 1;
+   unsigned long id;
+   long i;
+   int j, n;
+
+   for (i = 1; i < argc && argv[i][0] == '-'; i++) {
+      if (strcmp(argv[i], "-t") == 0 && i + 1 < argc)
+         num_lines = atol(argv[++i]);
+      else
+         usage();
+   }
+   if (argc - i != 1 || (num_entries = atol(argv[i])) < 1)
+      usage();
+
+   if (num_lines < 0) {
+      for (i = 0; i < num_entries; i++) {
+         get_word(i, buff);
+         printf("%s,-1,-1,5000," NOUN_EUC_JP ",*,*,*,*,%s," PRON_EUC_JP "," PRON_EUC_JP
+                ",1/1,C1\n", buff, buff);
+      }
+   } else {
+      for (i = 0; i < num_lines; i++) {
+         n = 4 + next_random(&seed) % 7;
+         for (j = 0; j < n; j++) {
+            id = next_random(&seed) << 15;
+            id |= next_random(&seed);
+            get_word(id % num_entries, buff);
+            fputs(buff, stdout);
+         }
+         putchar('\n');
+      }
+   }
+
+   return 0;
+}
@@ -0,0 +1,310 @@
+/* ----------------------------------------------------------------- */
+/*           The Japanese TTS System "Open JTalk"                    */
+/*           developed by HTS Working Group                          */
+/*           http://open-jtalk.sourceforge.net/                      */
+/* ----------------------------------------------------------------- */
+/*                                                                   */
+/*  Copyright (c) 2008-2011  Nagoya Institute of Technology          */
+/*                           Department of Computer Science          */
+/*                                                                   */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/* - Redistributions of source code must retain the above copyright  */
+/*   notice, this list of conditions and the following disclaimer.   */
+/* - Redistributions in binary form must reproduce the above         */
+/*   copyright notice, this list of conditions and the following     */
+/*   disclaimer in the documentation and/or other materials provided */
+/*   with the distribution.                                          */
+/* - Neither the name of the HTS working group nor the names of its  */
+/*   contributors may be used to endorse or promote products derived */
+/*   from this software without specific prior written permission.   */
+/*                                                                   */
+/* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND            */
+/* CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,       */
+/* INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF          */
+/* MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE          */
+/* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS */
+/* BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,          */
+/* EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED   */
+/* TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,     */
+/* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON */
+/* ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,   */
+/* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY    */
+/* OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE           */
+/* POSSIBILITY OF SUCH DAMAGE.                                       */
+/* ----------------------------------------------------------------- */
+/* Makes the labels of the first line of a text file with the front end of Open JTalk and
+   times HTS_Engine from HTS_Engine_create_pstream() through HTS_Engine_create_gstream() on them
+   with the voice in a directory, loaded as open_jtalk loads it without the low-pass filter
+   stream, and the time to the first vocoded frame, which -i (look-ahead frames of incremental
+   generation) shortens; with -i, GV is not loaded, as open_jtalk does not allow it. The minimum
+   and the median of the runs are reported. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "mecab.h"
+#include "njd.h"
+#include "jpcommon.h"
+#include "HTS_engine.h"
+#include "text2mecab.h"
+#include "mecab2njd.h"
+#include "njd_set_pronunciation.h"
+#include "njd_set_digit.h"
+#include "njd_set_accent_phrase.h"
+#include "njd_set_accent_type.h"
+#include "njd_set_unvoiced_vowel.h"
+#include "njd_set_long_vowel.h"
+#include "njd2jpcommon.h"
+
+#define MAXBUFLEN 1024
+
+static double get_time(void)
+{
+#if defined(CLOCK_MONOTONIC)
+   struct timespec ts;
+
+   clock_gettime(CLOCK_MONOTONIC, &ts);
+   return ts.tv_sec + ts.tv_nsec * 1e-9;
+#else
+   return (double) clock() / CLOCKS_PER_SEC;
+#endif                          /* CLOCK_MONOTONIC */
+}
+
+static int compare_double(const void *a, const void *b)
+{
+   const double x = *(const double *) a;
+   const double y = *(const double *) b;
+
+   return x < y ? -1 : (x > y ? 1 : 0);
+}
+
+/* return a newly allocated "dir/name" */
+static char *voice_file(const char *dir, const char *name)
+{
+   char *fn = (char *) malloc(strlen(dir) + strlen(name) + 2);
+
+   sprintf(fn, "%s/%s", dir, name);
+   return fn;
+}
+
+static void load_voice(HTS_Engine * engine, const char *dir, HTS_Boolean use_gv)
+{
+   char *ms, *ts;
+   char *ws[3];
+   int i;
+
+   ms = voice_file(dir, "dur.pdf");
+   ts = voice_file(dir, "tree-dur.inf");
+   HTS_Engine_load_duration_from_fn(engine, &ms, &ts, 1);
+   free(ms);
+   free(ts);
+
+   ms = voice_file(dir, "mgc.pdf");
+   ts = voice_file(dir, "tree-mgc.inf");
+   ws[0] = voice_file(dir, "mgc.win1");
+   ws[1] = voice_file(dir, "mgc.win2");
+   ws[2] = voice_file(dir, "mgc.win3");
+   HTS_Engine_load_parameter_from_fn(engine, &ms, &ts, ws, 0, FALSE, 3, 1);
+   free(ms);
+   free(ts);
+   for (i = 0; i < 3; i++)
+      free(ws[i]);
+
+   ms = voice_file(dir, "lf0.pdf");
+   ts = voice_file(dir, "tree-lf0.inf");
+   ws[0] = voice_file(dir, "lf0.win1");
+   ws[1] = voice_file(dir, "lf0.win2");
+   ws[2] = voice_file(dir, "lf0.win3");
+   HTS_Engine_load_parameter_from_fn(engine, &ms, &ts, ws, 1, TRUE, 3, 1);
+   free(ms);
+   free(ts);
+   for (i = 0; i < 3; i++)
+      free(ws[i]);
+
+   if (!use_gv)
+      return;
+
+   ms = voice_file(dir, "gv-mgc.pdf");
+   ts = voice_file(dir, "tree-gv-mgc.inf");
+   HTS_Engine_load_gv_from_fn(engine, &ms, &ts, 0, 1);
+   free(ms);
+   free(ts);
+
+   ms = voice_file(dir, "gv-lf0.pdf");
+   ts = voice_file(dir, "tree-gv-lf0.inf");
+   HTS_Engine_load_gv_from_fn(engine, &ms, &ts, 1, 1);
+   free(ms);
+   free(ts);
+
+   ms = voice_file(dir, "gv-switch.inf");
+   HTS_Engine_load_gv_switch_from_fn(engine, ms);
+   free(ms);
+}
+
+/* same passes as OpenJTalk_synthesis() in open_jtalk.c */
+static void make_label(Mecab * mecab, NJD * njd, JPCommon * jpcommon, const char *txt)
+{
+   char buff[MAXBUFLEN * 4];
+
+   text2mecab(buff, txt);
+   Mecab_analysis(mecab, buff);
+   mecab2njd_from_node(njd, Mecab_get_node(mecab));
+   njd_set_pronunciation(njd);
+   njd_set_digit(njd);
+   njd_set_accent_phrase(njd);
+   njd_set_accent_type(njd);
+   njd_set_unvoiced_vowel(njd);
+   njd_set_long_vowel(njd);
+   njd2jpcommon(jpcommon, njd);
+   JPCommon_make_label(jpcommon);
+}
+
+/* vocode the first frame as HTS_GStreamSet_create() does before any other */
+static void vocode_first_frame(HTS_Engine * engine, short *rawdata)
+{
+   HTS_PStreamSet *pss = &engine->pss;
+   const int m = HTS_PStreamSet_get_static_length(pss, 0) - 1;
+   HTS_Vocoder v;
+   double lf0 = LZERO;
+
+   HTS_PStreamSet_generate(pss, 1);
+   if (HTS_PStreamSet_get_msd_flag(pss, 1, 0))
+      lf0 = HTS_PStreamSet_get_parameter(pss, 1, 0, 0);
+   HTS_Vocoder_initialize(&v, m, engine->global.stage, engine->global.use_log_gain,
+                          engine->global.sampling_rate, engine->global.fperiod);
+   HTS_Vocoder_synthesize(&v, m, lf0, HTS_PStreamSet_get_parameter_vector(pss, 0, 0), 0, NULL,
+                          engine->global.alpha, engine->global.beta, engine->global.volume,
+                          rawdata, NULL);
+   HTS_Vocoder_clear(&v);
+}
+
+/* sort msec and return its median */
+static double median(double *msec, int num_runs)
+{
+   qsort(msec, num_runs, sizeof(double), compare_double);
+   return num_runs % 2 ? msec[num_runs / 2] : (msec[num_runs / 2 - 1] + msec[num_runs / 2]) / 2;
+}
+
+static void usage(void)
+{
+   fprintf(stderr,
+           "usage: synth_bench [-n runs] [-s sampling_rate] [-p fperiod] [-a alpha] [-i lookahead] dicdir voicedir textfile\n");
+   exit(1);
+}
+
+int main(int argc, char **argv)
+{
+   Mecab mecab;
+   NJD njd;
+   JPCommon jpcommon;
+   HTS_Engine engine;
+   FILE *fp;
+   char buff[MAXBUFLEN];
+   int num_runs = 6;
+   int sampling_rate = 48000;
+   int fperiod = 240;
+   double alpha = 0.55;
+   int lookahead = 0;
+   double *msec, *first_msec;
+   double med, first_med;
+   short *rawdata;
+   double start;
+   int nsample = 0;
+   int i, j;
+
+   for (i = 1; i < argc && argv[i][0] == '-'; i++) {
+      if (strcmp(argv[i], "-n") == 0 && i + 1 < argc)
+         num_runs = atoi(argv[++i]);
+      else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc)
+         sampling_rate = atoi(argv[++i]);
+      else if (strcmp(argv[i], "-p") == 0 && i + 1 < argc)
+         fperiod = atoi(argv[++i]);
+      else if (strcmp(argv[i], "-a") == 0 && i + 1 < argc)
+         alpha = atof(argv[++i]);
+      else if (strcmp(argv[i], "-i") == 0 && i + 1 < argc)
+         lookahead = atoi(argv[++i]);
+      else
+         usage();
+   }
+   if (argc - i != 3 || num_runs < 1 || lookahead < 0)
+      usage();
+
+   /* only the first line is synthesized, as open_jtalk does */
+   if ((fp = fopen(argv[i + 2], "r")) == NULL) {
+      fprintf(stderr, "ERROR: Cannot open %s.\n", argv[i + 2]);
+      return 1;
+   }
+   if (fgets(buff, MAXBUFLEN - 1, fp) == NULL)
+      buff[0] = '\0';
+   fclose(fp);
+
+   Mecab_initialize(&mecab);
+   NJD_initialize(&njd);
+   JPCommon_initialize(&jpcommon);
+   HTS_Engine_initialize(&engine, 2);
+   HTS_Engine_set_sampling_rate(&engine, sampling_rate);
+   HTS_Engine_set_fperiod(&engine, fperiod);
+   HTS_Engine_set_alpha(&engine, alpha);
+   HTS_Engine_set_gamma(&engine, 0);
+   HTS_Engine_set_log_gain(&engine, FALSE);
+   HTS_Engine_set_beta(&engine, 0.0);
+   HTS_Engine_set_audio_buff_size(&engine, 0);
+   HTS_Engine_set_msd_threshold(&engine, 1, 0.5);
+   HTS_Engine_set_gv_weight(&engine, 0, 1.0);
+   HTS_Engine_set_gv_weight(&engine, 1, 1.0);
+   HTS_Engine_set_lookahead(&engine, lookahead);
+   Mecab_load(&mecab, argv[i]);
+   load_voice(&engine, argv[i + 1], lookahead == 0);
+
+   make_label(&mecab, &njd, &jpcommon, buff);
+   if (JPCommon_get_label_size(&jpcommon) <= 2) {
+      fprintf(stderr, "ERROR: %s has no text to synthesize.\n", argv[i + 2]);
+      return 1;
+   }
+
+   /* the first run is not timed */
+   msec = (double *) malloc(num_runs * sizeof(double));
+   first_msec = (double *) malloc(num_runs * sizeof(double));
+   rawdata = (short *) malloc(fperiod * sizeof(short));
+   for (j = -1; j < num_runs; j++) {
+      HTS_Engine_load_label_from_string_list(&engine, JPCommon_get_label_feature(&jpcommon),
+                                             JPCommon_get_label_size(&jpcommon));
+      HTS_Engine_create_sstream(&engine);
+      start = get_time();
+      HTS_Engine_create_pstream(&engine);
+      vocode_first_frame(&engine, rawdata);
+      if (j >= 0)
+         first_msec[j] = (get_time() - start) * 1e3;
+      HTS_Engine_create_gstream(&engine);
+      if (j >= 0)
+         msec[j] = (get_time() - start) * 1e3;
+      nsample = HTS_GStreamSet_get_total_nsample(&engine.gss);
+      HTS_Engine_refresh(&engine);
+   }
+   med = median(msec, num_runs);
+   first_med = median(first_msec, num_runs);
+
+   printf("%d samples (%.1f s at %d Hz), %d runs, look-ahead %d frames%s\n", nsample,
+          (double) nsample / sampling_rate, sampling_rate, num_runs, lookahead,
+          lookahead > 0 ? " without GV" : "");
+   printf("create_pstream to first frame: min %.1f ms, median %.1f ms\n", first_msec[0],
+          first_med);
+   printf("create_pstream to create_gstream: min %.0f ms, median %.0f ms\n", msec[0], med);
+
+   free(rawdata);
+   free(first_msec);
+   free(msec);
+   Mecab_clear(&mecab);
+   NJD_clear(&njd);
+   JPCommon_clear(&jpcommon);
+   HTS_Engine_clear(&engine);
+
+   return 0;
+}
@@ -0,0 +1,127 @@
+/* ----------------------------------------------------------------- */
+/*           The Japanese TTS System "Open JTalk"                    */
+/*           developed by HTS Working Group                          */
+/*           http://open-jtalk.sourceforge.net/                      */
+/* ----------------------------------------------------------------- */
+/*                                                                   */
+/*  Copyright (c) 2008-2011  Nagoya Institute of Technology          */
+/*                           Department of Computer Science          */
+/*                                                                   */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/* - Redistributions of source code must retain the above copyright  */
+/*   notice, this list of conditions and the following disclaimer.   */
+/* - Redistributions in binary form must reproduce the above         */
+/*   copyright notice, this list of conditions and the following     */
+/*   disclaimer in the documentation and/or other materials provided */
+/*   with the distribution.                                          */
+/* - Neither the name of the HTS working group nor the names of its  */
+/*   contributors may be used to endorse or promote products derived */
+/*   from this software without specific prior written permission.   */
+/*                                                                   */
+/* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND            */
+/* CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,       */
+/* INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF          */
+/* MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE          */
+/* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS */
+/* BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,          */
+/* EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED   */
+/* TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,     */
+/* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON */
+/* ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,   */
+/* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY    */
+/* OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE           */
+/* POSSIBILITY OF SUCH DAMAGE.                                       */
+/* ----------------------------------------------------------------- */
+
+// Analyses a text with the given dictionary, writes the result as a training corpus
+// ("surface\tfeature" per morpheme, "EOS" after each sentence) and times mecab_cost_train()
+// on it. The time is printed to stderr, so that the iteration log on stdout can be kept apart.
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <sys/time.h>
+#include "mecab.h"
+
+namespace {
+
+const size_t kMaxLineSize = 8192;
+
+bool write_corpus(const char *dicdir, const char *text, const char *corpus) {
+  const std::string arg = std::string("-d ") + dicdir;
+  MeCab::Tagger *tagger = MeCab::createTagger(arg.c_str());
+  if (!tagger) {
+    std::fprintf(stderr, "%s\n", MeCab::getTaggerError());
+    return false;
+  }
+
+  std::FILE *ifp = std::fopen(text, "r");
+  std::FILE *ofp = std::fopen(corpus, "w");
+  if (!ifp || !ofp) {
+    std::fprintf(stderr, "cannot open %s\n", !ifp ? text : corpus);
+    if (ifp) std::fclose(ifp);
+    if (ofp) std::fclose(ofp);
+    delete tagger;
+    return false;
+  }
+
+  char line[kMaxLineSize];
+  while (std::fgets(line, sizeof(line), ifp)) {
+    line[std::strcspn(line, "\r\n")] = '\0';
+    if (line[0] == '\0') continue;
+    for (const MeCab::Node *node = tagger->parseToNode(line);
+         node; node = node->next) {
+      if (node->stat == MECAB_BOS_NODE) continue;
+      if (node->stat == MECAB_EOS_NODE) {
+        std::fprintf(ofp, "EOS\n");
+        continue;
+      }
+      std::fprintf(ofp, "%.*s\t%s\n", static_cast<int>(node->length),
+                   node->surface, node->feature);
+    }
+  }
+
+  std::fclose(ifp);
+  std::fclose(ofp);
+  delete tagger;
+  return true;
+}
+}
+
+int main(int argc, char **argv) {
+  if (argc < 5) {
+    std::fprintf(stderr, "usage: train_bench dicdir textfile corpus model "
+                 "[mecab-cost-train options]\n");
+    return 1;
+  }
+
+  if (!write_corpus(argv[1], argv[2], argv[3])) return 1;
+
+  // mecab-cost-train [options] -d dicdir corpus model
+  std::vector<char *> args;
+  args.push_back(argv[0]);
+  for (int i = 5; i < argc; ++i) args.push_back(argv[i]);
+  char dicdir_option[] = "-d";
+  args.push_back(dicdir_option);
+  args.push_back(argv[1]);
+  args.push_back(argv[3]);
+  args.push_back(argv[4]);
+  args.push_back(0);
+
+  struct timeval start, end;
+  gettimeofday(&start, 0);
+  const int result = mecab_cost_train(static_cast<int>(args.size() - 1),
+                                      &args[0]);
+  gettimeofday(&end, 0);
+
+  std::fprintf(stderr, "mecab_cost_train: %.2f s\n",
+               (end.tv_sec - start.tv_sec) +
+               (end.tv_usec - start.tv_usec) * 1e-6);
+  return result;
+}
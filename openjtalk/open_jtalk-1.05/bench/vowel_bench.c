@@ -0,0 +1,169 @@
+/* ----------------------------------------------------------------- */
+/*           The Japanese TTS System "Open JTalk"                    */
+/*           developed by HTS Working Group                          */
+/*           http://open-jtalk.sourceforge.net/                      */
+/* ----------------------------------------------------------------- */
+/*                                                                   */
+/*  Copyright (c) 2008-2011  Nagoya Institute of Technology          */
+/*                           Department of Computer Science          */
+/*                                                                   */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/* - Redistributions of source code must retain the above copyright  */
+/*   notice, this list of conditions and the following disclaimer.   */
+/* - Redistributions in binary form must reproduce the above         */
+/*   copyright notice, this list of conditions and the following     */
+/*   disclaimer in the documentation and/or other materials provided */
+/*   with the distribution.                                          */
+/* - Neither the name of the HTS working group nor the names of its  */
+/*   contributors may be used to endorse or promote products derived */
+/*   from this software without specific prior written permission.   */
+/*                                                                   */
+/* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND            */
+/* CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,       */
+/* INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF          */
+/* MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE          */
+/* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS */
+/* BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,          */
+/* EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED   */
+/* TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,     */
+/* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON */
+/* ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,   */
+/* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY    */
+/* OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE           */
+/* POSSIBILITY OF SUCH DAMAGE.                                       */
+/* ----------------------------------------------------------------- */
+
+/* Times njd_set_unvoiced_vowel() and njd_set_long_vowel() on NJD nodes whose prons are random
+   sequences of the morae listed in a file (one mora per line). Each size is the number of morae
+   per node; the prons are generated with a fixed seed so that runs are comparable. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "njd.h"
+#include "njd_set_unvoiced_vowel.h"
+#include "njd_set_long_vowel.h"
+
+#define MAXBUFLEN 1024
+#define MAXMORANUM 256
+#define NUM_NODES 32
+
+static const int mora_per_node[] = { 8, 64, 200 };
+
+static double get_time(void)
+{
+#if defined(CLOCK_MONOTONIC)
+   struct timespec ts;
+
+   clock_gettime(CLOCK_MONOTONIC, &ts);
+   return ts.tv_sec + ts.tv_nsec * 1e-9;
+#else
+   return (double) clock() / CLOCKS_PER_SEC;
+#endif                          /* CLOCK_MONOTONIC */
+}
+
+/* linear congruential generator, the same sequence on every platform */
+static unsigned long next_random(unsigned long *seed)
+{
+   *seed = (*seed * 1103515245UL + 12345UL) & 0x7fffffffUL;
+   return *seed >> 16;
+}
+
+static void usage(void)
+{
+   fprintf(stderr, "usage: vowel_bench [-n passes] moraefile\n");
+   exit(1);
+}
+
+int main(int argc, char **argv)
+{
+   FILE *fp;
+   char buff[MAXBUFLEN];
+   char *mora[MAXMORANUM];
+   int num_mora = 0;
+   size_t max_mora_len = 0;
+   int num_passes = 1000;
+   char *pron[NUM_NODES];
+   long num_bytes;
+   size_t len;
+   unsigned long seed = 1;
+   NJD njd;
+   NJDNode *node;
+   double start, sec;
+   int i, j, k, n;
+
+   for (i = 1; i < argc && argv[i][0] == '-'; i++) {
+      if (strcmp(argv[i], "-n") == 0 && i + 1 < argc)
+         num_passes = atoi(argv[++i]);
+      else
+         usage();
+   }
+   if (argc - i != 1 || num_passes < 1)
+      usage();
+
+   if ((fp = fopen(argv[i], "r")) == NULL) {
+      fprintf(stderr, "ERROR: Cannot open %s.\n", argv[i]);
+      return 1;
+   }
+   while (fgets(buff, MAXBUFLEN, fp) != NULL && num_mora < MAXMORANUM) {
+      buff[strcspn(buff, "\r\n")] = '\0';
+      if (buff[0] == '\0')
+         continue;
+      if (strlen(buff) > max_mora_len)
+         max_mora_len = strlen(buff);
+      mora[num_mora] = (char *) malloc(strlen(buff) + 1);
+      strcpy(mora[num_mora++], buff);
+   }
+   fclose(fp);
+   if (num_mora == 0) {
+      fprintf(stderr, "ERROR: %s has no mora.\n", argv[i]);
+      return 1;
+   }
+
+   NJD_initialize(&njd);
+   printf("%d nodes, %d passes\n", NUM_NODES, num_passes);
+   printf("%-12s %10s %10s\n", "morae/node", "ms/pass", "ns/byte");
+   for (n = 0; n < (int) (sizeof(mora_per_node) / sizeof(int)); n++) {
+      num_bytes = 0;
+      for (j = 0; j < NUM_NODES; j++) {
+         pron[j] = (char *) malloc(mora_per_node[n] * max_mora_len + 1);
+         for (k = 0, len = 0; k < mora_per_node[n]; k++) {
+            strcpy(pron[j] + len, mora[next_random(&seed) % num_mora]);
+            len += strlen(pron[j] + len);
+         }
+         num_bytes += len;
+      }
+      sec = 0.0;
+      for (i = 0; i < num_passes; i++) {
+         for (j = 0; j < NUM_NODES; j++) {
+            node = NJD_new_node(&njd);
+            NJDNode_set_pos(node, "*");
+            NJDNode_set_pron(node, pron[j]);
+            NJDNode_set_acc(node, 1);
+            NJDNode_set_mora_size(node, mora_per_node[n]);
+            NJD_push_node(&njd, node);
+         }
+         start = get_time();
+         njd_set_unvoiced_vowel(&njd);
+         njd_set_long_vowel(&njd);
+         sec += get_time() - start;
+         NJD_refresh(&njd);
+      }
+      printf("%-12d %10.3f %10.1f\n", mora_per_node[n], sec * 1e3 / num_passes,
+             sec * 1e9 / num_passes / num_bytes);
+      for (j = 0; j < NUM_NODES; j++)
+         free(pron[j]);
+   }
+   NJD_clear(&njd);
+   for (i = 0; i < num_mora; i++)
+      free(mora[i]);
+
+   return 0;
+}
@@ -72,6 +72,7 @@ OPEN_JTALK_C_START;
 #include "njd_set_accent_type.h"
 #include "njd_set_unvoiced_vowel.h"
 #include "njd_set_long_vowel.h"
+#include "njd_set_accent_and_vowel.h"
 #include "njd2jpcommon.h"
 
 #define MAXBUFLEN 1024
@@ -86,7 +87,8 @@ typedef struct _OpenJTalk {
 void OpenJTalk_initialize(OpenJTalk * open_jtalk, HTS_Boolean use_lpf, int sampling_rate,
                           int fperiod, double alpha, int stage, double beta, int audio_buff_size,
                           double uv_threshold, HTS_Boolean use_log_gain, double gv_weight_mgc,
-                          double gv_weight_lf0, double gv_weight_lpf)
+                          double gv_weight_lf0, double gv_weight_lpf, int num_threads,
+                          int lookahead)
 {
    Mecab_initialize(&open_jtalk->mecab);
    NJD_initialize(&open_jtalk->njd);
@@ -107,6 +109,8 @@ void OpenJTalk_initialize(OpenJTalk * open_jtalk, HTS_Boolean use_lpf, int sampl
    HTS_Engine_set_gv_weight(&open_jtalk->engine, 1, gv_weight_lf0);
    if (use_lpf)
       HTS_Engine_set_gv_weight(&open_jtalk->engine, 2, gv_weight_lpf);
+   HTS_Engine_set_num_threads(&open_jtalk->engine, num_threads);
+   HTS_Engine_set_lookahead(&open_jtalk->engine, lookahead);
 }
 
 void OpenJTalk_load(OpenJTalk * open_jtalk, char *dn_mecab, char *fn_ms_dur, char *fn_ts_dur,
@@ -153,14 +157,10 @@ void OpenJTalk_synthesis(OpenJTalk * open_jtalk, char *txt, FILE * wavfp, FILE *
 
    text2mecab(buff, txt);
    Mecab_analysis(&open_jtalk->mecab, buff);
-   mecab2njd(&open_jtalk->njd, Mecab_get_feature(&open_jtalk->mecab),
-             Mecab_get_size(&open_jtalk->mecab));
+   mecab2njd_from_node(&open_jtalk->njd, Mecab_get_node(&open_jtalk->mecab));
    njd_set_pronunciation(&open_jtalk->njd);
    njd_set_digit(&open_jtalk->njd);
-   njd_set_accent_phrase(&open_jtalk->njd);
-   njd_set_accent_type(&open_jtalk->njd);
-   njd_set_unvoiced_vowel(&open_jtalk->njd);
-   njd_set_long_vowel(&open_jtalk->njd);
+   njd_set_accent_and_vowel(&open_jtalk->njd);
    njd2jpcommon(&open_jtalk->jpcommon, &open_jtalk->njd);
    JPCommon_make_label(&open_jtalk->jpcommon);
    if (JPCommon_get_label_size(&open_jtalk->jpcommon) > 2) {
@@ -285,6 +285,10 @@ void Usage()
            "    -k  tree       : use GV switch                                           [  N/A]\n");
    fprintf(stderr,
            "    -z  i          : audio buffer size                                       [ 1600][   0--48000]\n");
+   fprintf(stderr,
+           "    -n  i          : number of threads for parameter generation (without -i) [    1][   1--]\n");
+   fprintf(stderr,
+           "    -i  i          : look-ahead frames for incremental generation (no GV)    [    0][   0--]\n");
    fprintf(stderr, "  infile:\n");
    fprintf(stderr,
            "    text file                                                                [stdin]\n");
@@ -370,6 +374,8 @@ int main(int argc, char **argv)
    double gv_weight_lpf = 1.0;
    HTS_Boolean use_log_gain = FALSE;
    HTS_Boolean use_lpf = FALSE;
+   int num_threads = 1;
+   int lookahead = 0;
 
    /* parse command line */
    if (argc == 1)
@@ -563,6 +569,14 @@ int main(int argc, char **argv)
             audio_buff_size = atoi(*++argv);
             --argc;
             break;
+         case 'n':
+            num_threads = atoi(*++argv);
+            --argc;
+            break;
+         case 'i':
+            lookahead = atoi(*++argv);
+            --argc;
+            break;
          default:
             fprintf(stderr, "ERROR: main() in open_jtalk.c: Invalid option '-%c'.\n", *(*argv + 1));
             exit(1);
@@ -587,11 +601,21 @@ int main(int argc, char **argv)
    }
    if (fn_ms_lpf != NULL && fn_ts_lpf != NULL && num_ws_lpf > 0)
       use_lpf = TRUE;
+   /* incremental generation runs on one thread */
+   if (num_threads > 1 && lookahead > 0) {
+      fprintf(stderr, "ERROR: main() in open_jtalk.c: -n and -i cannot be used together.\n");
+      exit(1);
+   }
+   /* GV is only approximated in incremental generation */
+   if (lookahead > 0 && (fn_ms_gvm != NULL || fn_ms_gvl != NULL || fn_ms_gvf != NULL)) {
+      fprintf(stderr, "ERROR: main() in open_jtalk.c: -i cannot be used with GV (-cm, -cl, -cf).\n");
+      exit(1);
+   }
 
    /* initialize and load */
    OpenJTalk_initialize(&open_jtalk, use_lpf, sampling_rate, fperiod, alpha, stage, beta,
                         audio_buff_size, uv_threshold, use_log_gain, gv_weight_mgc,
-                        gv_weight_lf0, gv_weight_lpf);
+                        gv_weight_lf0, gv_weight_lpf, num_threads, lookahead);
    OpenJTalk_load(&open_jtalk, dn_mecab, fn_ms_dur, fn_ts_dur, fn_ms_mgc, fn_ts_mgc,
                   fn_ws_mgc, num_ws_mgc, fn_ms_lf0, fn_ts_lf0, fn_ws_lf0, num_ws_lf0,
                   fn_ms_lpf, fn_ts_lpf, fn_ws_lpf, num_ws_lpf, fn_ms_gvm, fn_ts_gvm,
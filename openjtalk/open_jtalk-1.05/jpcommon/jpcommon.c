@@ -57,11 +57,15 @@ JPCOMMON_C_START;
 
 #include "jpcommon.h"
 
+/* label structures are aligned as malloc() aligns them */
+#define JPCOMMON_ARENA_ALIGN 16
+
 void JPCommon_initialize(JPCommon * jpcommon)
 {
    jpcommon->head = NULL;
    jpcommon->tail = NULL;
    jpcommon->label = NULL;
+   NJDArena_initialize(&jpcommon->arena, JPCOMMON_ARENA_ALIGN);
 }
 
 void JPCommon_push(JPCommon * jpcommon, JPCommonNode * node)
@@ -80,17 +84,16 @@ void JPCommon_make_label(JPCommon * jpcommon)
    JPCommonNode *node = jpcommon->head;
 
    /* initialize */
-   if (jpcommon->label != NULL)
-      JPCommonLabel_clear(jpcommon->label);
-   else
-      jpcommon->label = (JPCommonLabel *) calloc(1, sizeof(JPCommonLabel));
-   JPCommonLabel_initialize(jpcommon->label);
+   if (jpcommon->label == NULL)
+      jpcommon->label =
+          (JPCommonLabel *) NJDArena_calloc(&jpcommon->arena, 1, sizeof(JPCommonLabel));
+   JPCommonLabel_initialize(jpcommon->label, &jpcommon->arena);
    /* push word */
    for (node = jpcommon->head; node != NULL; node = node->next)
       JPCommonLabel_push_word(jpcommon->label, JPCommonNode_get_pron(node),
-                              JPCommonNode_get_pos(node),
-                              JPCommonNode_get_ctype(node),
-                              JPCommonNode_get_cform(node),
+                              JPCommonNode_get_pos_id(node),
+                              JPCommonNode_get_ctype_id(node),
+                              JPCommonNode_get_cform_id(node),
                               JPCommonNode_get_acc(node), JPCommonNode_get_chain_flag(node));
    /* make label */
    JPCommonLabel_make(jpcommon->label);
@@ -125,13 +128,7 @@ void JPCommon_fprint(JPCommon * jpcommon, FILE * fp)
       JPCommonNode_fprint(node, fp);
 }
 
-void JPCommon_refresh(JPCommon * jpcommon)
-{
-   JPCommon_clear(jpcommon);
-   JPCommon_initialize(jpcommon);
-}
-
-void JPCommon_clear(JPCommon * jpcommon)
+static void JPCommon_clear_node(JPCommon * jpcommon)
 {
    JPCommonNode *node;
 
@@ -142,12 +139,23 @@ void JPCommon_clear(JPCommon * jpcommon)
       jpcommon->head = node;
    }
    jpcommon->tail = NULL;
+}
+
+void JPCommon_refresh(JPCommon * jpcommon)
+{
+   JPCommon_clear_node(jpcommon);
+
+   /* keep the arena blocks for the next utterance */
+   jpcommon->label = NULL;
+   NJDArena_reset(&jpcommon->arena);
+}
+
+void JPCommon_clear(JPCommon * jpcommon)
+{
+   JPCommon_clear_node(jpcommon);
 
-   if (jpcommon->label != NULL) {
-      JPCommonLabel_clear(jpcommon->label);
-      free(jpcommon->label);
-   }
    jpcommon->label = NULL;
+   NJDArena_clear(&jpcommon->arena);
 }
 
 JPCOMMON_C_END;
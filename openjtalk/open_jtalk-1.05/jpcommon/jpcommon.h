@@ -49,6 +49,8 @@
 #define JPCOMMON_H_END
 #endif                          /* __CPLUSPLUS */
 
+#include "njd.h"
+
 JPCOMMON_H_START;
 
 /* JPCommonLabel */
@@ -60,14 +62,14 @@ struct _JPCommonLabelAccentPhrase;
 struct _JPCommonLabelBreathGroup;
 
 typedef struct _JPCommonLabelPhoneme {
-   char *phoneme;
+   const char *phoneme;
    struct _JPCommonLabelPhoneme *prev;
    struct _JPCommonLabelPhoneme *next;
    struct _JPCommonLabelMora *up;
 } JPCommonLabelPhoneme;
 
 typedef struct _JPCommonLabelMora {
-   char *mora;
+   const char *mora;
    struct _JPCommonLabelPhoneme *head;
    struct _JPCommonLabelPhoneme *tail;
    struct _JPCommonLabelMora *prev;
@@ -77,9 +79,9 @@ typedef struct _JPCommonLabelMora {
 
 typedef struct _JPCommonLabelWord {
    char *pron;
-   char *pos;
-   char *ctype;
-   char *cform;
+   const char *pos;
+   const char *ctype;
+   const char *cform;
    struct _JPCommonLabelMora *head;
    struct _JPCommonLabelMora *tail;
    struct _JPCommonLabelWord *prev;
@@ -89,7 +91,7 @@ typedef struct _JPCommonLabelWord {
 
 typedef struct _JPCommonLabelAccentPhrase {
    int accent;
-   char *emotion;
+   const char *emotion;
    struct _JPCommonLabelWord *head;
    struct _JPCommonLabelWord *tail;
    struct _JPCommonLabelAccentPhrase *prev;
@@ -118,25 +120,32 @@ typedef struct _JPCommonLabel {
    JPCommonLabelPhoneme *phoneme_head;
    JPCommonLabelPhoneme *phoneme_tail;
    int short_pause_flag;
+   NJDArena *arena;
 } JPCommonLabel;
 
-void JPCommonLabel_initialize(JPCommonLabel * label);
-void JPCommonLabel_push_word(JPCommonLabel * label, char *pron, char *pos,
-                             char *ctype, char *cform, int acc, int chain_flag);
+void JPCommonLabel_initialize(JPCommonLabel * label, NJDArena * arena);
+void JPCommonLabel_push_word(JPCommonLabel * label, char *pron, int pos,
+                             int ctype, int cform, int acc, int chain_flag);
 void JPCommonLabel_make(JPCommonLabel * label);
 int JPCommonLabel_get_size(JPCommonLabel * label);
 char **JPCommonLabel_get_feature(JPCommonLabel * label);
 void JPCommonLabel_print(JPCommonLabel * label);
 void JPCommonLabel_fprint(JPCommonLabel * label, FILE * fp);
 void JPCommonLabel_clear(JPCommonLabel * label);
+int JPCommonLabel_get_pos_id(const char *pos);
+int JPCommonLabel_get_ctype_id(const char *ctype);
+int JPCommonLabel_get_cform_id(const char *cform);
+const char *JPCommonLabel_get_pos_name(int pos);
+const char *JPCommonLabel_get_ctype_name(int ctype);
+const char *JPCommonLabel_get_cform_name(int cform);
 
 /* JPCommonNode */
 
 typedef struct _JPCommonNode {
    char *pron;                  /* pronunciation */
-   char *pos;                   /* part of speech */
-   char *ctype;                 /* conjugation type */
-   char *cform;                 /* conjugation form */
+   int pos;                     /* part of speech ID */
+   int ctype;                   /* conjugation type ID */
+   int cform;                   /* conjugation form ID */
    int acc;                     /* accent type */
    int chain_flag;              /* chain flag */
    struct _JPCommonNode *prev;
@@ -148,12 +157,18 @@ void JPCommonNode_set_pron(JPCommonNode * node, char *str);
 void JPCommonNode_set_pos(JPCommonNode * node, char *str);
 void JPCommonNode_set_ctype(JPCommonNode * node, char *str);
 void JPCommonNode_set_cform(JPCommonNode * node, char *str);
+void JPCommonNode_set_pos_id(JPCommonNode * node, int pos);
+void JPCommonNode_set_ctype_id(JPCommonNode * node, int ctype);
+void JPCommonNode_set_cform_id(JPCommonNode * node, int cform);
 void JPCommonNode_set_acc(JPCommonNode * node, int acc);
 void JPCommonNode_set_chain_flag(JPCommonNode * node, int flag);
 char *JPCommonNode_get_pron(JPCommonNode * node);
-char *JPCommonNode_get_pos(JPCommonNode * node);
-char *JPCommonNode_get_ctype(JPCommonNode * node);
-char *JPCommonNode_get_cform(JPCommonNode * node);
+const char *JPCommonNode_get_pos(JPCommonNode * node);
+const char *JPCommonNode_get_ctype(JPCommonNode * node);
+const char *JPCommonNode_get_cform(JPCommonNode * node);
+int JPCommonNode_get_pos_id(JPCommonNode * node);
+int JPCommonNode_get_ctype_id(JPCommonNode * node);
+int JPCommonNode_get_cform_id(JPCommonNode * node);
 int JPCommonNode_get_acc(JPCommonNode * node);
 int JPCommonNode_get_chain_flag(JPCommonNode * node);
 void JPCommonNode_print(JPCommonNode * node);
@@ -166,6 +181,7 @@ typedef struct _JPCommon {
    JPCommonNode *head;
    JPCommonNode *tail;
    JPCommonLabel *label;
+   NJDArena arena;
 } JPCommon;
 
 void JPCommon_initialize(JPCommon * jpcommon);
@@ -69,6 +69,10 @@ JPCOMMON_LABEL_C_START;
 
 #define MAXBUFLEN 1024
 
+/* label structures are allocated from the per-utterance arena of JPCommon */
+#define JPCOMMON_LABEL_NEW(label, type) \
+   ((type *) NJDArena_calloc((label)->arena, 1, sizeof(type)))
+
 static int strtopcmp(char *str, const char *pattern)
 {
    int i;
@@ -83,11 +87,20 @@ static int strtopcmp(char *str, const char *pattern)
    }
 }
 
+static NJDTrie jpcommon_mora_trie;
+static NJDOnce jpcommon_mora_trie_once = NJD_ONCE_INIT;
+
+static void initialize_mora_trie(void)
+{
+   NJDTrie_initialize(&jpcommon_mora_trie, jpcommon_mora_list, 3);
+}
+
+/* phoneme, mora, POS and emotion strings point into the rule tables and are never copied */
 static void JPCommonLabelPhoneme_initialize(JPCommonLabelPhoneme * p, const char *phoneme,
                                             JPCommonLabelPhoneme * prev,
                                             JPCommonLabelPhoneme * next, JPCommonLabelMora * up)
 {
-   p->phoneme = strdup(phoneme);
+   p->phoneme = phoneme;
    p->prev = prev;
    p->next = next;
    p->up = up;
@@ -99,8 +112,7 @@ static void JPCommonLabelPhoneme_convert_unvoice(JPCommonLabelPhoneme * p)
 
    for (i = 0; jpcommon_unvoice_list[i] != NULL; i += 2) {
       if (strcmp(jpcommon_unvoice_list[i], p->phoneme) == 0) {
-         free(p->phoneme);
-         p->phoneme = strdup(jpcommon_unvoice_list[i + 1]);
+         p->phoneme = jpcommon_unvoice_list[i + 1];
          return;
       }
    }
@@ -110,17 +122,12 @@ static void JPCommonLabelPhoneme_convert_unvoice(JPCommonLabelPhoneme * p)
            p->phoneme);
 }
 
-static void JPCommonLabelPhoneme_clear(JPCommonLabelPhoneme * p)
-{
-   free(p->phoneme);
-}
-
 static void JPCommonLabelMora_initialize(JPCommonLabelMora * m, const char *mora,
                                          JPCommonLabelPhoneme * head, JPCommonLabelPhoneme * tail,
                                          JPCommonLabelMora * prev, JPCommonLabelMora * next,
                                          JPCommonLabelWord * up)
 {
-   m->mora = strdup(mora);
+   m->mora = mora;
    m->head = head;
    m->tail = tail;
    m->prev = prev;
@@ -128,84 +135,30 @@ static void JPCommonLabelMora_initialize(JPCommonLabelMora * m, const char *mora
    m->up = up;
 }
 
-static void JPCommonLabelMora_clear(JPCommonLabelMora * m)
+static void JPCommonLabelWord_initialize(JPCommonLabelWord * w, NJDArena * arena,
+                                         const char *pron, int pos, int ctype, int cform,
+                                         JPCommonLabelMora * head, JPCommonLabelMora * tail,
+                                         JPCommonLabelWord * prev, JPCommonLabelWord * next)
 {
-   free(m->mora);
-}
-
-static void JPCommonLabelWord_initialize(JPCommonLabelWord * w, const char *pron, char *pos,
-                                         char *ctype, char *cform, JPCommonLabelMora * head,
-                                         JPCommonLabelMora * tail, JPCommonLabelWord * prev,
-                                         JPCommonLabelWord * next)
-{
-   int i, find;
-
-   w->pron = strdup(pron);
-   for (i = 0, find = 0; jpcommon_pos_list[i] != NULL; i += 2) {
-      if (strcmp(jpcommon_pos_list[i], pos) == 0) {
-         find = 1;
-         break;
-      }
-   }
-   if (find == 0) {
-      fprintf(stderr,
-              "WARNING: JPCommonLabelWord_initializel() in jpcommon_label.c: %s is unknown POS.\n",
-              pos);
-      i = 0;
-   }
-   w->pos = strdup(jpcommon_pos_list[i + 1]);
-   for (i = 0, find = 0; jpcommon_ctype_list[i] != NULL; i += 2) {
-      if (strcmp(jpcommon_ctype_list[i], ctype) == 0) {
-         find = 1;
-         break;
-      }
-   }
-   if (find == 0) {
-      fprintf(stderr,
-              "WARNING: JPCommonLabelWord_initializel() in jpcommon_label.c: %s is unknown conjugation type.\n",
-              ctype);
-      i = 0;
-   }
-   w->ctype = strdup(jpcommon_ctype_list[i + 1]);
-   for (i = 0, find = 0; jpcommon_cform_list[i] != NULL; i += 2) {
-      if (strcmp(jpcommon_cform_list[i], cform) == 0) {
-         find = 1;
-         break;
-      }
-   }
-   if (find == 0) {
-      fprintf(stderr,
-              "WARNING: JPCommonLabelWord_initializel() in jpcommon_label.c: %s is unknown conjugation form .\n",
-              cform);
-      i = 0;
-   }
-   w->cform = strdup(jpcommon_cform_list[i + 1]);
+   w->pron = NJDArena_strndup(arena, pron, strlen(pron));
+   w->pos = jpcommon_pos_list[pos * 2 + 1];
+   w->ctype = jpcommon_ctype_list[ctype * 2 + 1];
+   w->cform = jpcommon_cform_list[cform * 2 + 1];
    w->head = head;
    w->tail = tail;
    w->prev = prev;
    w->next = next;
 }
 
-static void JPCommonLabelWord_clear(JPCommonLabelWord * w)
-{
-   free(w->pron);
-   free(w->pos);
-   free(w->ctype);
-   free(w->cform);
-}
-
 static void JPCommonLabelAccentPhrase_initialize(JPCommonLabelAccentPhrase * a, int acc,
-                                                 char *emotion, JPCommonLabelWord * head,
+                                                 const char *emotion, JPCommonLabelWord * head,
                                                  JPCommonLabelWord * tail,
                                                  JPCommonLabelAccentPhrase * prev,
                                                  JPCommonLabelAccentPhrase * next,
                                                  JPCommonLabelBreathGroup * up)
 {
    a->accent = acc;
-   if (emotion != NULL)
-      a->emotion = strdup(emotion);
-   else
-      a->emotion = NULL;
+   a->emotion = emotion;
    a->head = head;
    a->tail = tail;
    a->prev = prev;
@@ -213,12 +166,6 @@ static void JPCommonLabelAccentPhrase_initialize(JPCommonLabelAccentPhrase * a,
    a->up = up;
 }
 
-static void JPCommonLabelAccentPhrase_clear(JPCommonLabelAccentPhrase * a)
-{
-   if (a->emotion != NULL)
-      free(a->emotion);
-}
-
 static void JPCommonLabelBreathGroup_initialize(JPCommonLabelBreathGroup * b,
                                                 JPCommonLabelAccentPhrase * head,
                                                 JPCommonLabelAccentPhrase * tail,
@@ -231,10 +178,6 @@ static void JPCommonLabelBreathGroup_initialize(JPCommonLabelBreathGroup * b,
    b->next = next;
 }
 
-static void JPCommonLabelBreathGroup_clear(JPCommonLabelBreathGroup * b)
-{
-}
-
 static int index_mora_in_accent_phrase(JPCommonLabelMora * m)
 {
    int i;
@@ -372,8 +315,10 @@ static int count_mora_in_utterance(JPCommonLabelMora * m)
    return index_mora_in_utterance(m) + i;
 }
 
-void JPCommonLabel_initialize(JPCommonLabel * label)
+void JPCommonLabel_initialize(JPCommonLabel * label, NJDArena * arena)
 {
+   label->size = 0;
+   label->feature = NULL;
    label->short_pause_flag = 0;
    label->breath_head = NULL;
    label->breath_tail = NULL;
@@ -385,6 +330,7 @@ void JPCommonLabel_initialize(JPCommonLabel * label)
    label->mora_tail = NULL;
    label->phoneme_head = NULL;
    label->phoneme_tail = NULL;
+   label->arena = arena;
 }
 
 static void JPCommonLabel_insert_pause(JPCommonLabel * label)
@@ -397,8 +343,7 @@ static void JPCommonLabel_insert_pause(JPCommonLabel * label)
                     "WARNING: JPCommonLabel_insert_word() in jpcommon_label.c: Short pause should not be chained.\n");
             return;
          }
-         label->phoneme_tail->next =
-             (JPCommonLabelPhoneme *) calloc(1, sizeof(JPCommonLabelPhoneme));
+         label->phoneme_tail->next = JPCOMMON_LABEL_NEW(label, JPCommonLabelPhoneme);
          JPCommonLabelPhoneme_initialize(label->phoneme_tail->next, JPCOMMON_PHONEME_SHORT_PAUSE,
                                          label->phoneme_tail, NULL, NULL);
          label->phoneme_tail = label->phoneme_tail->next;
@@ -410,7 +355,7 @@ static void JPCommonLabel_insert_pause(JPCommonLabel * label)
    }
 }
 
-void JPCommonLabel_push_word(JPCommonLabel * label, char *pron, char *pos, char *ctype, char *cform,
+void JPCommonLabel_push_word(JPCommonLabel * label, char *pron, int pos, int ctype, int cform,
                              int acc, int chain_flag)
 {
    int i;
@@ -427,10 +372,10 @@ void JPCommonLabel_push_word(JPCommonLabel * label, char *pron, char *pos, char
       if (label->phoneme_tail != NULL) {
          if (strcmp(label->phoneme_tail->phoneme, JPCOMMON_PHONEME_SHORT_PAUSE) == 0) {
             if (label->phoneme_tail->prev->up->up->up->emotion == NULL)
-               label->phoneme_tail->prev->up->up->up->emotion = strdup(JPCOMMON_FLAG_QUESTION);
+               label->phoneme_tail->prev->up->up->up->emotion = JPCOMMON_FLAG_QUESTION;
          } else {
             if (label->phoneme_tail->up->up->up->emotion == NULL)
-               label->phoneme_tail->up->up->up->emotion = strdup(JPCOMMON_FLAG_QUESTION);
+               label->phoneme_tail->up->up->up->emotion = JPCOMMON_FLAG_QUESTION;
          }
       } else {
          fprintf(stderr,
@@ -446,9 +391,8 @@ void JPCommonLabel_push_word(JPCommonLabel * label, char *pron, char *pos, char
          /* for long vowel */
          if (label->phoneme_tail != NULL) {
             JPCommonLabel_insert_pause(label);
-            label->phoneme_tail->next =
-                (JPCommonLabelPhoneme *) calloc(1, sizeof(JPCommonLabelPhoneme));
-            label->mora_tail->next = (JPCommonLabelMora *) calloc(1, sizeof(JPCommonLabelMora));
+            label->phoneme_tail->next = JPCOMMON_LABEL_NEW(label, JPCommonLabelPhoneme);
+            label->mora_tail->next = JPCOMMON_LABEL_NEW(label, JPCommonLabelMora);
             JPCommonLabelPhoneme_initialize(label->phoneme_tail->next, label->phoneme_tail->phoneme,
                                             label->phoneme_tail, NULL, label->mora_tail->next);
             JPCommonLabelMora_initialize(label->mora_tail->next, JPCOMMON_MORA_LONG_VOWEL,
@@ -474,25 +418,24 @@ void JPCommonLabel_push_word(JPCommonLabel * label, char *pron, char *pos, char
             pron += find;
          } else {
             /* for normal word */
-            for (i = 0; jpcommon_mora_list[i] != NULL; i += 3) {
-               find = strtopcmp(pron, jpcommon_mora_list[i]);
-               if (find != -1)
-                  break;
-            }
+            NJDOnce_call(&jpcommon_mora_trie_once, initialize_mora_trie);
+            i = NJDTrie_find(&jpcommon_mora_trie, pron, &find);
+            if (i < 0)
+               find = -1;
             if (find != -1) {
                if (label->phoneme_tail == NULL) {
                   JPCommonLabel_insert_pause(label);
-                  label->phoneme_tail =
-                      (JPCommonLabelPhoneme *) calloc(1, sizeof(JPCommonLabelPhoneme));
-                  label->mora_tail = (JPCommonLabelMora *) calloc(1, sizeof(JPCommonLabelMora));
-                  label->word_tail = (JPCommonLabelWord *) calloc(1, sizeof(JPCommonLabelWord));
+                  label->phoneme_tail = JPCOMMON_LABEL_NEW(label, JPCommonLabelPhoneme);
+                  label->mora_tail = JPCOMMON_LABEL_NEW(label, JPCommonLabelMora);
+                  label->word_tail = JPCOMMON_LABEL_NEW(label, JPCommonLabelWord);
                   JPCommonLabelPhoneme_initialize(label->phoneme_tail, jpcommon_mora_list[i + 1],
                                                   NULL, NULL, label->mora_tail);
                   JPCommonLabelMora_initialize(label->mora_tail, jpcommon_mora_list[i],
                                                label->phoneme_tail, label->phoneme_tail, NULL, NULL,
                                                label->word_tail);
-                  JPCommonLabelWord_initialize(label->word_tail, pron, pos, ctype, cform,
-                                               label->mora_tail, label->mora_tail, NULL, NULL);
+                  JPCommonLabelWord_initialize(label->word_tail, label->arena, pron, pos, ctype,
+                                               cform, label->mora_tail, label->mora_tail, NULL,
+                                               NULL);
                   label->phoneme_head = label->phoneme_tail;
                   label->mora_head = label->mora_tail;
                   label->word_head = label->word_tail;
@@ -500,12 +443,9 @@ void JPCommonLabel_push_word(JPCommonLabel * label, char *pron, char *pos, char
                } else {
                   if (is_first_word == 1) {
                      JPCommonLabel_insert_pause(label);
-                     label->phoneme_tail->next =
-                         (JPCommonLabelPhoneme *) calloc(1, sizeof(JPCommonLabelPhoneme));
-                     label->mora_tail->next =
-                         (JPCommonLabelMora *) calloc(1, sizeof(JPCommonLabelMora));
-                     label->word_tail->next =
-                         (JPCommonLabelWord *) calloc(1, sizeof(JPCommonLabelWord));
+                     label->phoneme_tail->next = JPCOMMON_LABEL_NEW(label, JPCommonLabelPhoneme);
+                     label->mora_tail->next = JPCOMMON_LABEL_NEW(label, JPCommonLabelMora);
+                     label->word_tail->next = JPCOMMON_LABEL_NEW(label, JPCommonLabelWord);
                      JPCommonLabelPhoneme_initialize(label->phoneme_tail->next,
                                                      jpcommon_mora_list[i + 1], label->phoneme_tail,
                                                      NULL, label->mora_tail->next);
@@ -513,19 +453,17 @@ void JPCommonLabel_push_word(JPCommonLabel * label, char *pron, char *pos, char
                                                   label->phoneme_tail->next,
                                                   label->phoneme_tail->next, label->mora_tail, NULL,
                                                   label->word_tail->next);
-                     JPCommonLabelWord_initialize(label->word_tail->next, pron, pos, ctype, cform,
-                                                  label->mora_tail->next, label->mora_tail->next,
-                                                  label->word_tail, NULL);
+                     JPCommonLabelWord_initialize(label->word_tail->next, label->arena, pron, pos,
+                                                  ctype, cform, label->mora_tail->next,
+                                                  label->mora_tail->next, label->word_tail, NULL);
                      label->phoneme_tail = label->phoneme_tail->next;
                      label->mora_tail = label->mora_tail->next;
                      label->word_tail = label->word_tail->next;
                      is_first_word = 0;
                   } else {
                      JPCommonLabel_insert_pause(label);
-                     label->phoneme_tail->next =
-                         (JPCommonLabelPhoneme *) calloc(1, sizeof(JPCommonLabelPhoneme));
-                     label->mora_tail->next =
-                         (JPCommonLabelMora *) calloc(1, sizeof(JPCommonLabelMora));
+                     label->phoneme_tail->next = JPCOMMON_LABEL_NEW(label, JPCommonLabelPhoneme);
+                     label->mora_tail->next = JPCOMMON_LABEL_NEW(label, JPCommonLabelMora);
                      JPCommonLabelPhoneme_initialize(label->phoneme_tail->next,
                                                      jpcommon_mora_list[i + 1], label->phoneme_tail,
                                                      NULL, label->mora_tail->next);
@@ -540,8 +478,7 @@ void JPCommonLabel_push_word(JPCommonLabel * label, char *pron, char *pos, char
                }
                if (jpcommon_mora_list[i + 2] != NULL) {
                   JPCommonLabel_insert_pause(label);
-                  label->phoneme_tail->next =
-                      (JPCommonLabelPhoneme *) calloc(1, sizeof(JPCommonLabelPhoneme));
+                  label->phoneme_tail->next = JPCOMMON_LABEL_NEW(label, JPCommonLabelPhoneme);
                   JPCommonLabelPhoneme_initialize(label->phoneme_tail->next,
                                                   jpcommon_mora_list[i + 2], label->phoneme_tail,
                                                   NULL, label->mora_tail);
@@ -570,9 +507,8 @@ void JPCommonLabel_push_word(JPCommonLabel * label, char *pron, char *pos, char
    /* make accent, phrase */
    if (label->word_head == label->word_tail) {
       /* first word */
-      label->accent_tail =
-          (JPCommonLabelAccentPhrase *) calloc(1, sizeof(JPCommonLabelAccentPhrase));
-      label->breath_tail = (JPCommonLabelBreathGroup *) calloc(1, sizeof(JPCommonLabelBreathGroup));
+      label->accent_tail = JPCOMMON_LABEL_NEW(label, JPCommonLabelAccentPhrase);
+      label->breath_tail = JPCOMMON_LABEL_NEW(label, JPCommonLabelBreathGroup);
       label->word_tail->up = label->accent_tail;
       JPCommonLabelAccentPhrase_initialize(label->accent_tail, acc, NULL, label->word_tail,
                                            label->word_tail, NULL, NULL, label->breath_tail);
@@ -588,8 +524,7 @@ void JPCommonLabel_push_word(JPCommonLabel * label, char *pron, char *pos, char
        if (strcmp
            (label->word_tail->prev->tail->tail->next->phoneme, JPCOMMON_PHONEME_SHORT_PAUSE) != 0) {
       /* different accent phrase && common phrase */
-      label->accent_tail->next =
-          (JPCommonLabelAccentPhrase *) calloc(1, sizeof(JPCommonLabelAccentPhrase));
+      label->accent_tail->next = JPCOMMON_LABEL_NEW(label, JPCommonLabelAccentPhrase);
       label->word_tail->up = label->accent_tail->next;
       JPCommonLabelAccentPhrase_initialize(label->accent_tail->next, acc, NULL, label->word_tail,
                                            label->word_tail, label->accent_tail, NULL,
@@ -598,10 +533,8 @@ void JPCommonLabel_push_word(JPCommonLabel * label, char *pron, char *pos, char
       label->accent_tail = label->accent_tail->next;
    } else {
       /* different accent phrase && different phrase */
-      label->accent_tail->next =
-          (JPCommonLabelAccentPhrase *) calloc(1, sizeof(JPCommonLabelAccentPhrase));
-      label->breath_tail->next =
-          (JPCommonLabelBreathGroup *) calloc(1, sizeof(JPCommonLabelBreathGroup));
+      label->accent_tail->next = JPCOMMON_LABEL_NEW(label, JPCommonLabelAccentPhrase);
+      label->breath_tail->next = JPCOMMON_LABEL_NEW(label, JPCommonLabelBreathGroup);
       label->word_tail->up = label->accent_tail->next;
       JPCommonLabelAccentPhrase_initialize(label->accent_tail->next, acc, NULL, label->word_tail,
                                            label->word_tail, label->accent_tail, NULL,
@@ -620,7 +553,7 @@ void JPCommonLabel_make(JPCommonLabel * label)
    JPCommonLabelWord *w;
    JPCommonLabelAccentPhrase *a;
    JPCommonLabelBreathGroup *b;
-   char **phoneme_list;
+   const char **phoneme_list;
    int short_pause_flag;
 
    /* initialize */
@@ -631,12 +564,14 @@ void JPCommonLabel_make(JPCommonLabel * label)
       return;
    }
    label->size += 2;
-   label->feature = (char **) calloc(label->size, sizeof(char *));
-   for (i = 0; i < label->size; i++)
-      label->feature[i] = (char *) calloc(MAXBUFLEN, sizeof(char));
+   label->feature = (char **) NJDArena_alloc(label->arena, label->size * sizeof(char *));
+   label->feature[0] = (char *) NJDArena_alloc(label->arena, label->size * MAXBUFLEN);
+   for (i = 1; i < label->size; i++)
+      label->feature[i] = label->feature[i - 1] + MAXBUFLEN;
 
    /* phoneme list */
-   phoneme_list = (char **) calloc(label->size + 4, sizeof(char *));
+   phoneme_list =
+       (const char **) NJDArena_alloc(label->arena, (label->size + 4) * sizeof(char *));
    phoneme_list[0] = JPCOMMON_PHONEME_UNKNOWN;
    phoneme_list[1] = JPCOMMON_PHONEME_UNKNOWN;
    phoneme_list[2] = JPCOMMON_PHONEME_SILENT;
@@ -808,9 +743,6 @@ void JPCommonLabel_make(JPCommonLabel * label)
       if (0 < i && i < label->size - 2)
          p = p->next;
    }
-
-   /* free */
-   free(phoneme_list);
 }
 
 int JPCommonLabel_get_size(JPCommonLabel * label)
@@ -864,44 +796,49 @@ void JPCommonLabel_fprint(JPCommonLabel * label, FILE * fp)
 }
 
 void JPCommonLabel_clear(JPCommonLabel * label)
+{
+   /* all structures and features are owned by the arena */
+   JPCommonLabel_initialize(label, label->arena);
+}
+
+static int JPCommonLabel_find(const char **list, const char *str)
 {
    int i;
-   JPCommonLabelPhoneme *p, *pn;
-   JPCommonLabelMora *m, *mn;
-   JPCommonLabelWord *w, *wn;
-   JPCommonLabelAccentPhrase *a, *an;
-   JPCommonLabelBreathGroup *b, *bn;
-
-   for (p = label->phoneme_head; p != NULL; p = pn) {
-      pn = p->next;
-      JPCommonLabelPhoneme_clear(p);
-      free(p);
-   }
-   for (m = label->mora_head; m != NULL; m = mn) {
-      mn = m->next;
-      JPCommonLabelMora_clear(m);
-      free(m);
-   }
-   for (w = label->word_head; w != NULL; w = wn) {
-      wn = w->next;
-      JPCommonLabelWord_clear(w);
-      free(w);
-   }
-   for (a = label->accent_head; a != NULL; a = an) {
-      an = a->next;
-      JPCommonLabelAccentPhrase_clear(a);
-      free(a);
-   }
-   for (b = label->breath_head; b != NULL; b = bn) {
-      bn = b->next;
-      JPCommonLabelBreathGroup_clear(b);
-      free(b);
-   }
-   if (label->feature != NULL) {
-      for (i = 0; i < label->size; i++)
-         free(label->feature[i]);
-      free(label->feature);
-   }
+
+   for (i = 0; list[i] != NULL; i += 2)
+      if (strcmp(list[i], str) == 0)
+         return i / 2;
+   return -1;
+}
+
+int JPCommonLabel_get_pos_id(const char *pos)
+{
+   return JPCommonLabel_find(jpcommon_pos_list, pos);
+}
+
+int JPCommonLabel_get_ctype_id(const char *ctype)
+{
+   return JPCommonLabel_find(jpcommon_ctype_list, ctype);
+}
+
+int JPCommonLabel_get_cform_id(const char *cform)
+{
+   return JPCommonLabel_find(jpcommon_cform_list, cform);
+}
+
+const char *JPCommonLabel_get_pos_name(int pos)
+{
+   return jpcommon_pos_list[pos * 2];
+}
+
+const char *JPCommonLabel_get_ctype_name(int ctype)
+{
+   return jpcommon_ctype_list[ctype * 2];
+}
+
+const char *JPCommonLabel_get_cform_name(int cform)
+{
+   return jpcommon_cform_list[cform * 2];
 }
 
 JPCOMMON_LABEL_C_END;
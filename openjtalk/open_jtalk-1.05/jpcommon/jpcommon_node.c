@@ -60,9 +60,9 @@ JPCOMMON_NODE_C_START;
 void JPCommonNode_initialize(JPCommonNode * node)
 {
    node->pron = NULL;
-   node->pos = NULL;
-   node->ctype = NULL;
-   node->cform = NULL;
+   node->pos = 0;
+   node->ctype = 0;
+   node->cform = 0;
    node->acc = 0;
    node->chain_flag = 0;
    node->prev = NULL;
@@ -78,23 +78,49 @@ void JPCommonNode_set_pron(JPCommonNode * node, char *str)
 
 void JPCommonNode_set_pos(JPCommonNode * node, char *str)
 {
-   if (node->pos != NULL)
-      free(node->pos);
-   node->pos = strdup(str);
+   node->pos = JPCommonLabel_get_pos_id(str);
+   if (node->pos < 0) {
+      fprintf(stderr, "WARNING: JPCommonNode_set_pos() in jpcommon_node.c: %s is unknown POS.\n",
+              str);
+      node->pos = 0;
+   }
 }
 
 void JPCommonNode_set_ctype(JPCommonNode * node, char *str)
 {
-   if (node->ctype != NULL)
-      free(node->ctype);
-   node->ctype = strdup(str);
+   node->ctype = JPCommonLabel_get_ctype_id(str);
+   if (node->ctype < 0) {
+      fprintf(stderr,
+              "WARNING: JPCommonNode_set_ctype() in jpcommon_node.c: %s is unknown conjugation type.\n",
+              str);
+      node->ctype = 0;
+   }
 }
 
 void JPCommonNode_set_cform(JPCommonNode * node, char *str)
 {
-   if (node->cform != NULL)
-      free(node->cform);
-   node->cform = strdup(str);
+   node->cform = JPCommonLabel_get_cform_id(str);
+   if (node->cform < 0) {
+      fprintf(stderr,
+              "WARNING: JPCommonNode_set_cform() in jpcommon_node.c: %s is unknown conjugation form.\n",
+              str);
+      node->cform = 0;
+   }
+}
+
+void JPCommonNode_set_pos_id(JPCommonNode * node, int pos)
+{
+   node->pos = pos;
+}
+
+void JPCommonNode_set_ctype_id(JPCommonNode * node, int ctype)
+{
+   node->ctype = ctype;
+}
+
+void JPCommonNode_set_cform_id(JPCommonNode * node, int cform)
+{
+   node->cform = cform;
 }
 
 void JPCommonNode_set_acc(JPCommonNode * node, int acc)
@@ -112,17 +138,32 @@ char *JPCommonNode_get_pron(JPCommonNode * node)
    return node->pron;
 }
 
-char *JPCommonNode_get_pos(JPCommonNode * node)
+const char *JPCommonNode_get_pos(JPCommonNode * node)
+{
+   return JPCommonLabel_get_pos_name(node->pos);
+}
+
+const char *JPCommonNode_get_ctype(JPCommonNode * node)
+{
+   return JPCommonLabel_get_ctype_name(node->ctype);
+}
+
+const char *JPCommonNode_get_cform(JPCommonNode * node)
+{
+   return JPCommonLabel_get_cform_name(node->cform);
+}
+
+int JPCommonNode_get_pos_id(JPCommonNode * node)
 {
    return node->pos;
 }
 
-char *JPCommonNode_get_ctype(JPCommonNode * node)
+int JPCommonNode_get_ctype_id(JPCommonNode * node)
 {
    return node->ctype;
 }
 
-char *JPCommonNode_get_cform(JPCommonNode * node)
+int JPCommonNode_get_cform_id(JPCommonNode * node)
 {
    return node->cform;
 }
@@ -140,9 +181,9 @@ int JPCommonNode_get_chain_flag(JPCommonNode * node)
 void JPCommonNode_copy(JPCommonNode * node1, JPCommonNode * node2)
 {
    JPCommonNode_set_pron(node1, node2->pron);
-   JPCommonNode_set_pos(node1, node2->pos);
-   JPCommonNode_set_ctype(node1, node2->ctype);
-   JPCommonNode_set_cform(node1, node2->cform);
+   JPCommonNode_set_pos_id(node1, node2->pos);
+   JPCommonNode_set_ctype_id(node1, node2->ctype);
+   JPCommonNode_set_cform_id(node1, node2->cform);
    JPCommonNode_set_acc(node1, node2->acc);
    JPCommonNode_set_chain_flag(node1, node2->chain_flag);
 }
@@ -154,8 +195,9 @@ void JPCommonNode_print(JPCommonNode * node)
 
 void JPCommonNode_fprint(JPCommonNode * node, FILE * fp)
 {
-   fprintf(fp, "%s,%s,%s,%s,%d,%d\n", node->pron, node->pos, node->ctype, node->cform, node->acc,
-           node->chain_flag);
+   fprintf(fp, "%s,%s,%s,%s,%d,%d\n", node->pron, JPCommonLabel_get_pos_name(node->pos),
+           JPCommonLabel_get_ctype_name(node->ctype), JPCommonLabel_get_cform_name(node->cform),
+           node->acc, node->chain_flag);
 }
 
 void JPCommonNode_clear(JPCommonNode * node)
@@ -164,18 +206,9 @@ void JPCommonNode_clear(JPCommonNode * node)
       free(node->pron);
       node->pron = NULL;
    }
-   if (node->pos != NULL) {
-      free(node->pos);
-      node->pos = NULL;
-   }
-   if (node->ctype != NULL) {
-      free(node->ctype);
-      node->ctype = NULL;
-   }
-   if (node->cform != NULL) {
-      free(node->cform);
-      node->cform = NULL;
-   }
+   node->pos = 0;
+   node->ctype = 0;
+   node->cform = 0;
    node->acc = 0;
    node->chain_flag = 0;
    node->prev = NULL;
@@ -123,7 +123,13 @@
 #define NBEST_MAX 512
 #define NODE_FREELIST_SIZE 512
 #define PATH_FREELIST_SIZE 2048
+#define NODE_FREELIST_MAX 32      // blocks kept after a long sentence
+#define PATH_FREELIST_MAX 32
+#define LOOKUP_PREFETCH_SIZE 4    // characters walked ahead of lookup()
+#define LOOKUP_PREFETCH_STEP 3    // units each walk advances per lookup()
+#define LOOKUP_PREFETCH_MIN  (1 << 20)  // smaller double arrays stay cached
 #define MIN_INPUT_BUFFER_SIZE 8192
+#define MAX_LATTICE_BUFFER_SIZE 8192*8
 #define MAX_INPUT_BUFFER_SIZE 8192*640
 #define BUF_SIZE 8192
 
@@ -135,13 +141,40 @@
 #define EXIT_SUCCESS 0
 #endif
 
+#if defined(_MSC_VER)
+#define MECAB_THREAD_LOCAL __declspec(thread)
+#else
+#define MECAB_THREAD_LOCAL __thread
+#endif
+
+#if __cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1900)
+#define MECAB_DIE_NOEXCEPT noexcept(false)
+#else
+#define MECAB_DIE_NOEXCEPT
+#endif
+
 namespace MeCab {
 
+  // while a die_trap lives on the thread, CHECK_DIE writes to its stream_
+  // and throws die_error instead of exiting the process
+  class die_trap {
+  public:
+    std::ostringstream stream_;
+    die_trap();
+    ~die_trap();
+    static die_trap *current();
+  private:
+    die_trap *prev_;
+  };
+
+  struct die_error {};
+
   class die {
   public:
     die() {}
-    ~die() { std::cerr << std::endl; exit(-1); }
+    ~die() MECAB_DIE_NOEXCEPT;
     int operator&(std::ostream&) { return 0; }
+    static std::ostream &stream();
   };
 
   class warn {
@@ -193,7 +226,7 @@ if (condition) {} else \
     __FILE__ << "(" << __LINE__ << ") [" << #condition << "] "
 
 #define CHECK_DIE(condition) \
-(condition) ? 0 : die() & std::cerr << __FILE__ << \
+(condition) ? 0 : die() & die::stream() << __FILE__ << \
 "(" << __LINE__ << ") [" << #condition << "] "
 
 #define CHECK_WARN(condition) \
@@ -39,6 +39,11 @@ class Connector {
     return matrix_[ lNode->rcAttr + lsize_ * rNode->lcAttr ] + rNode->wcost;
   }
 
+  // costs from every right context id to |lcAttr|, indexed by rcAttr
+  inline const short *row(unsigned short lcAttr) const {
+    return matrix_ + lsize_ * lcAttr;
+  }
+
   // access to raw matrix
   short *mutable_matrix() { return &matrix_[0]; }
   const short *matrix() const { return &matrix_[0]; }
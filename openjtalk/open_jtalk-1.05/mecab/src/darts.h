@@ -20,6 +20,16 @@ namespace zlib {
 #define LG(p)((unsigned long)(SH(p)) |((unsigned long)(SH((p)+2)) << 16))
 #endif
 
+#if defined(__GNUC__)
+#define DARTS_PREFETCH(p) __builtin_prefetch(p)
+#elif defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+#include <xmmintrin.h>
+#define DARTS_PREFETCH(p) \
+  _mm_prefetch(reinterpret_cast<const char *>(p), _MM_HINT_T0)
+#else
+#define DARTS_PREFETCH(p)
+#endif
+
 namespace MeCab {
 
 namespace Darts {
@@ -216,6 +226,13 @@ class DoubleArrayImpl {
     size_t     length;
   };
 
+  // cursor of a walk that runs ahead of commonPrefixSearch() on the same key
+  struct prefetch_type {
+    const key_type *key;
+    size_t          len;
+    array_type_     b;
+  };
+
   explicit DoubleArrayImpl(): array_(0), used_(0),
                               size_(0), alloc_size_(0),
                               no_delete_(0), error_(0) {}
@@ -463,6 +480,34 @@ class DoubleArrayImpl {
     return num;
   }
 
+  // prefetchStart() and prefetchNext() follow the same transitions as
+  // commonPrefixSearch(), one unit per call, and only touch the cache
+  // lines the search will read at the next depth.  Interleaving the walks
+  // of several keys hides the misses of a double array larger than cache.
+  void prefetchStart(prefetch_type *w, const key_type *key,
+                     size_t len, size_t node_pos = 0) const {
+    w->key = key;
+    w->len = len;
+    w->b   = array_[node_pos].base;
+    DARTS_PREFETCH(&array_[w->b]);
+    if (len) DARTS_PREFETCH(&array_[w->b + (node_u_type_)(*key) + 1]);
+  }
+
+  bool prefetchNext(prefetch_type *w) const {
+    if (!w->len) return false;
+    array_u_type_ p = w->b + (node_u_type_)(*w->key) + 1;
+    if ((array_u_type_) w->b != array_[p].check) {
+      w->len = 0;
+      return false;
+    }
+    w->b = array_[p].base;
+    ++w->key;
+    --w->len;
+    DARTS_PREFETCH(&array_[w->b]);
+    if (w->len) DARTS_PREFETCH(&array_[w->b + (node_u_type_)(*w->key) + 1]);
+    return true;
+  }
+
   value_type traverse(const key_type *key,
                       size_t &node_pos,
                       size_t &key_pos,
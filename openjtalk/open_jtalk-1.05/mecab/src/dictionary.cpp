@@ -16,6 +16,7 @@
 #include "scoped_ptr.h"
 #include "writer.h"
 #include "mmap.h"
+#include "thread.h"
 
 namespace MeCab {
 
@@ -60,7 +61,8 @@ bool Dictionary::open(const char *file,
 
   charset_ = ptr;
   ptr += 32;
-  da_.set_array(reinterpret_cast<void *>(const_cast<char*>(ptr)));
+  da_.set_array(reinterpret_cast<void *>(const_cast<char*>(ptr)),
+                dsize / da_.unit_size());
 
   ptr += dsize;
 
@@ -80,6 +82,188 @@ void Dictionary::close() {
   MMAP_CLOSE(char, dmmap_);
 }
 
+namespace {
+
+// lines parsed per batch; each batch is split over the threads
+static const size_t DictionaryBatchSize = 16384;
+
+struct DictionaryEntry {
+  enum { ENTRY_OK, ENTRY_SKIP, ENTRY_NO_REWRITE, ENTRY_ERROR };
+  int status;
+  int lid;
+  int rid;
+  int pid;
+  int cost;
+  std::string w;
+  std::string feature;
+  std::string message;
+};
+
+// Parses one CSV line into an entry.  The shared tables are only read,
+// so one parser per thread can run concurrently; errors are returned in
+// the entry and reported by the caller in input order.
+class DictionaryParser {
+ private:
+  const Connector          *matrix_;
+  const POSIDGenerator     *posid_;
+  const DictionaryRewriter *rewrite_;
+  const ContextID          *cid_;
+  int                       type_;
+  Iconv                     iconv_;
+  scoped_ptr<Writer>        writer_;
+  scoped_ptr<StringBuffer>  os_;
+  std::string               node_format_;
+  std::string               ufeature_, lfeature_, rfeature_;
+  Node                      node_;
+  char                      line_[BUF_SIZE];
+
+ public:
+  bool open(const Param &param,
+            const Connector *matrix,
+            const POSIDGenerator *posid) {
+    const std::string from = param.get<std::string>("dictionary-charset");
+    const std::string to = param.get<std::string>("charset");
+    matrix_ = matrix;
+    posid_ = posid;
+    rewrite_ = 0;
+    cid_ = 0;
+    type_ = param.get<int>("type");
+    node_format_ = param.get<std::string>("node-format");
+    if (!node_format_.empty()) {
+      writer_.reset(new Writer);
+      os_.reset(new StringBuffer);
+      std::memset(&node_, 0, sizeof(node_));
+    }
+    return iconv_.open(from.c_str(), to.c_str());
+  }
+
+  void set_rewrite(const DictionaryRewriter *rewrite,
+                   const ContextID *cid) {
+    rewrite_ = rewrite;
+    cid_ = cid;
+  }
+
+  void parse(const std::string &line, DictionaryEntry *e) {
+    e->status = DictionaryEntry::ENTRY_ERROR;
+    e->message.clear();
+
+    CHECK_DIE(line.size() < sizeof(line_)) << "too long line";
+    std::memcpy(line_, line.c_str(), line.size() + 1);
+    char *col[8];
+    const size_t n = tokenizeCSV(line_, col, 5);
+    if (n != 5) {
+      e->message = "format error: " + line;
+      return;
+    }
+
+    e->w = col[0];
+    e->lid = std::atoi(col[1]);
+    e->rid = std::atoi(col[2]);
+    e->cost = std::atoi(col[3]);
+    e->feature = col[4];
+    e->pid = posid_->id(e->feature.c_str());
+
+    if (e->lid < 0  || e->rid < 0) {
+      if (!rewrite_) {
+        e->status = DictionaryEntry::ENTRY_NO_REWRITE;
+        return;
+      }
+
+      if (!rewrite_->rewrite(e->feature, &ufeature_, &lfeature_, &rfeature_)) {
+        e->message = "rewrite failed: " + e->feature;
+        return;
+      }
+
+      e->lid = cid_->lid(lfeature_.c_str());
+      e->rid = cid_->rid(rfeature_.c_str());
+    }
+
+    if (!(e->lid >= 0 && e->rid >= 0 && matrix_->is_valid(e->lid, e->rid))) {
+      std::ostringstream os;
+      os << "invalid ids are found lid=" << e->lid << " rid=" << e->rid;
+      e->message = os.str();
+      return;
+    }
+
+    e->status = DictionaryEntry::ENTRY_SKIP;
+
+    if (e->w.empty()) {
+      e->message = "empty word is found, discard this line";
+      return;
+    }
+
+    if (!iconv_.convert(&e->feature)) {
+      e->message = "iconv conversion failed. skip this entry";
+      return;
+    }
+
+    if (type_ != MECAB_UNK_DIC && !iconv_.convert(&e->w)) {
+      e->message = "iconv conversion failed. skip this entry";
+      return;
+    }
+
+    if (!node_format_.empty()) {
+      node_.surface = e->w.c_str();
+      node_.feature = e->feature.c_str();
+      node_.length  = e->w.size();
+      node_.rlength = e->w.size();
+      node_.posid   = e->pid;
+      node_.stat    = MECAB_NOR_NODE;
+      os_->clear();
+      if (!writer_->writeNode(&*os_, node_format_.c_str(),
+                              e->w.c_str(), &node_)) {
+        e->status = DictionaryEntry::ENTRY_ERROR;
+        e->message = "conversion error: " + e->feature +
+            " with " + node_format_;
+        return;
+      }
+      *os_ << '\0';
+      e->feature = os_->str();
+    }
+
+    e->status = DictionaryEntry::ENTRY_OK;
+  }
+};
+
+#ifdef MECAB_USE_THREAD
+class dictionary_thread: public thread {
+ public:
+  size_t start_i;
+  size_t thread_num;
+  size_t size;
+  const std::string *lines;
+  DictionaryEntry *entries;
+  DictionaryParser *parser;
+  void run() {
+    for (size_t i = start_i; i < size; i += thread_num)
+      parser->parse(lines[i], &entries[i]);
+  }
+};
+#endif
+
+// orders entries by surface; equal surfaces keep their input order
+class DictionaryKeyLess {
+ private:
+  const char *sbuf_;
+  const std::vector<std::pair<size_t, size_t> > *key_;
+
+ public:
+  DictionaryKeyLess(const char *sbuf,
+                    const std::vector<std::pair<size_t, size_t> > *key):
+      sbuf_(sbuf), key_(key) {}
+
+  bool operator()(unsigned int a, unsigned int b) const {
+    const std::pair<size_t, size_t> &ka = (*key_)[a];
+    const std::pair<size_t, size_t> &kb = (*key_)[b];
+    const int r = std::memcmp(sbuf_ + ka.first, sbuf_ + kb.first,
+                              std::min(ka.second, kb.second));
+    if (r != 0) return r < 0;
+    if (ka.second != kb.second) return ka.second < kb.second;
+    return a < b;
+  }
+};
+}
+
 bool Dictionary::compile(const Param &param,
                          const std::vector<std::string> &dics,
                          const char *matrix_file,
@@ -93,22 +277,22 @@ bool Dictionary::compile(const Param &param,
   scoped_ptr<DictionaryRewriter> rewrite(0);
   scoped_ptr<POSIDGenerator> posid(0);
   scoped_ptr<ContextID> cid(0);
-  scoped_ptr<Writer> writer(0);
-  scoped_ptr<StringBuffer> os(0);
-  Node node;
 
-  std::vector<std::pair<std::string, Token*> > dic;
+  // surfaces are packed into |sbuf|, indexed by |key| (offset, length)
+  std::string sbuf;
+  std::vector<std::pair<size_t, size_t> > key;
+  std::vector<Token> token;
 
   size_t offset  = 0;
   unsigned int lexsize = 0;
-  std::string w, feature, ufeature, lfeature, rfeature, fbuf, key;
-  int lid, rid, cost;
+  std::string fbuf;
 
   const std::string from = param.get<std::string>("dictionary-charset");
   const std::string to = param.get<std::string>("charset");
   const bool wakati = param.get<bool>("wakati");
+  const bool quiet = param.get<bool>("quiet");  // no progress on stdout
   const int type = param.get<int>("type");
-  const std::string node_format = param.get<std::string>("node-format");
+  const size_t thread_num = std::max(param.get<int>("thread"), 1);
 
   // for backward compatibility
   std::string config_charset = param.get<std::string>("config-charset");
@@ -116,21 +300,12 @@ bool Dictionary::compile(const Param &param,
 
   CHECK_DIE(!from.empty()) << "input dictionary charset is empty";
   CHECK_DIE(!to.empty())   << "output dictionary charset is empty";
-
-  Iconv iconv;
-  CHECK_DIE(iconv.open(from.c_str(), to.c_str()))
-      << "iconv_open() failed with from=" << from << " to=" << to;
+  CHECK_DIE(thread_num <= 512) << "# thread is invalid: " << thread_num;
 
   Iconv config_iconv;
   CHECK_DIE(config_iconv.open(config_charset.c_str(), from.c_str()))
       << "iconv_open() failed with from=" << config_charset << " to=" << from;
 
-  if (!node_format.empty()) {
-    writer.reset(new Writer);
-    os.reset(new StringBuffer);
-    memset(&node, 0, sizeof(node));
-  }
-
   if (!matrix.openText(matrix_file) &&
       !matrix.open(matrix_bin_file)) {
     matrix.set_left_size(1);
@@ -140,6 +315,18 @@ bool Dictionary::compile(const Param &param,
   posid.reset(new POSIDGenerator);
   posid->open(pos_id_file, &config_iconv);
 
+  // one parser (with its own iconv and writer) per thread
+  scoped_array<scoped_ptr<DictionaryParser> >
+      parser(new scoped_ptr<DictionaryParser>[thread_num]);
+  for (size_t i = 0; i < thread_num; ++i) {
+    parser[i].reset(new DictionaryParser);
+    CHECK_DIE(parser[i]->open(param, &matrix, &*posid))
+        << "iconv_open() failed with from=" << from << " to=" << to;
+  }
+
+  std::vector<std::string> lines(DictionaryBatchSize);
+  std::vector<DictionaryEntry> entries(DictionaryBatchSize);
+
   std::istringstream iss(UNK_DEF_DEFAULT);
 
   for (size_t i = 0; i < dics.size(); ++i) {
@@ -155,164 +342,155 @@ bool Dictionary::compile(const Param &param,
       }
     }
 
-    std::cout << "reading " << dics[i] << " ... ";
+    if (!quiet) std::cout << "reading " << dics[i] << " ... ";
 
     char line[BUF_SIZE];
     size_t num = 0;
 
-    while (is->getline(line, sizeof(line))) {
-      char *col[8];
-      const size_t n = tokenizeCSV(line, col, 5);
-      CHECK_DIE(n == 5) << "format error: " << line;
-
-      w = col[0];
-      lid = std::atoi(col[1]);
-      rid = std::atoi(col[2]);
-      cost = std::atoi(col[3]);
-      feature = col[4];
-      int pid = posid->id(feature.c_str());
-
-      if (lid < 0  || rid < 0) {
-        if (!rewrite.get()) {
-          rewrite.reset(new DictionaryRewriter);
-          rewrite->open(rewrite_file, &config_iconv);
-        }
-
-        CHECK_DIE(rewrite->rewrite(feature, &ufeature, &lfeature, &rfeature))
-            << "rewrite failed: " << feature;
-
-        if (!cid.get()) {
-          cid.reset(new ContextID);
-          cid->open(left_id_file, right_id_file, &config_iconv);
-          CHECK_DIE(cid->left_size()  == matrix.left_size() &&
-                    cid->right_size() == matrix.right_size())
-              << "Context ID files("
-              << left_id_file
-              << " or "
-              << right_id_file << " may be broken";
+    for (bool eof = false; !eof;) {
+      size_t size = 0;
+      while (size < lines.size() && is->getline(line, sizeof(line)))
+        lines[size++] = line;
+      eof = (size < lines.size());
+
+#ifdef MECAB_USE_THREAD
+      if (thread_num > 1) {
+        std::vector<dictionary_thread> thread(thread_num);
+        for (size_t k = 0; k < thread_num; ++k) {
+          thread[k].start_i = k;
+          thread[k].thread_num = thread_num;
+          thread[k].size = size;
+          thread[k].lines = &lines[0];
+          thread[k].entries = &entries[0];
+          thread[k].parser = parser[k].get();
+          thread[k].start();
         }
-
-        lid = cid->lid(lfeature.c_str());
-        rid = cid->rid(rfeature.c_str());
+        for (size_t k = 0; k < thread_num; ++k)
+          thread[k].join();
+      } else {
+        for (size_t k = 0; k < size; ++k)
+          parser[0]->parse(lines[k], &entries[k]);
       }
+#else
+      for (size_t k = 0; k < size; ++k)
+        parser[0]->parse(lines[k], &entries[k]);
+#endif
+
+      for (size_t k = 0; k < size; ++k) {
+        DictionaryEntry &e = entries[k];
+
+        if (e.status == DictionaryEntry::ENTRY_NO_REWRITE) {
+          // the rewrite rules are loaded on the first entry that needs them
+          if (!rewrite.get()) {
+            rewrite.reset(new DictionaryRewriter);
+            rewrite->open(rewrite_file, &config_iconv);
+          }
+
+          if (!cid.get()) {
+            cid.reset(new ContextID);
+            cid->open(left_id_file, right_id_file, &config_iconv);
+            CHECK_DIE(cid->left_size()  == matrix.left_size() &&
+                      cid->right_size() == matrix.right_size())
+                << "Context ID files("
+                << left_id_file
+                << " or "
+                << right_id_file << " may be broken";
+          }
+
+          for (size_t j = 0; j < thread_num; ++j)
+            parser[j]->set_rewrite(&*rewrite, &*cid);
+          parser[0]->parse(lines[k], &e);
+        }
 
-      CHECK_DIE(lid >= 0 && rid >= 0 && matrix.is_valid(lid, rid))
-          << "invalid ids are found lid=" << lid << " rid=" << rid;
+        CHECK_DIE(e.status != DictionaryEntry::ENTRY_ERROR) << e.message;
 
-      if (w.empty()) {
-        std::cerr << "empty word is found, discard this line" << std::endl;
-        continue;
-      }
-
-      if (!iconv.convert(&feature)) {
-        std::cerr << "iconv conversion failed. skip this entry"
-                  << std::endl;
-        continue;
-      }
+        if (e.status == DictionaryEntry::ENTRY_SKIP) {
+          std::cerr << e.message << std::endl;
+          continue;
+        }
 
-      if (type != MECAB_UNK_DIC && !iconv.convert(&w)) {
-        std::cerr << "iconv conversion failed. skip this entry"
-                  << std::endl;
-        continue;
-      }
+        key.push_back(std::make_pair(sbuf.size(), e.w.size()));
+        sbuf.append(e.w);
+
+        Token t;
+        t.lcAttr = e.lid;
+        t.rcAttr = e.rid;
+        t.posid  = e.pid;
+        t.wcost = e.cost;
+        t.feature = offset;
+        t.compound = 0;
+        token.push_back(t);
+
+        // append to output buffer
+        if (!wakati) {
+          fbuf.append(e.feature.data(), e.feature.size());
+          fbuf.append("\0", 1);
+          offset += e.feature.size() + 1;
+        }
 
-      if (!node_format.empty()) {
-        node.surface = w.c_str();
-        node.feature = feature.c_str();
-        node.length  = w.size();
-        node.rlength = w.size();
-        node.posid   = pid;
-        node.stat    = MECAB_NOR_NODE;
-        CHECK_DIE(os.get());
-        CHECK_DIE(writer.get());
-        os->clear();
-        CHECK_DIE(writer->writeNode(&*os,
-                                    node_format.c_str(),
-                                    w.c_str(),
-                                    &node)) <<
-            "conversion error: " << feature << " with " << node_format;
-        *os << '\0';
-        feature = os->str();
+        ++num;
+        ++lexsize;
       }
-
-      key.clear();
-      if (!wakati) key = feature + '\0';
-
-      Token* token  = new Token;
-      token->lcAttr = lid;
-      token->rcAttr = rid;
-      token->posid  = pid;
-      token->wcost = cost;
-      token->feature = offset;
-      token->compound = 0;
-      dic.push_back(std::make_pair<std::string, Token*>(w, token));
-
-      // append to output buffer
-      if (!wakati) fbuf.append(key.data(), key.size());
-      offset += key.size();
-
-      ++num;
-      ++lexsize;
     }
 
-    std::cout << num << std::endl;
+    if (!quiet) std::cout << num << std::endl;
   }
 
+  parser.reset();
+  std::vector<std::string>().swap(lines);
+  std::vector<DictionaryEntry>().swap(entries);
+
   if (wakati) fbuf.append("\0", 1);
 
-  std::sort(dic.begin(), dic.end());
+  std::vector<unsigned int> dic(token.size());
+  for (size_t i = 0; i < dic.size(); ++i) dic[i] = i;
+  std::sort(dic.begin(), dic.end(), DictionaryKeyLess(sbuf.data(), &key));
 
   size_t bsize = 0;
   size_t idx = 0;
-  std::string prev;
   std::vector<const char *> str;
   std::vector<size_t> len;
   std::vector<Darts::DoubleArray::result_type> val;
 
   for (size_t i = 0; i < dic.size(); ++i) {
-    if (i != 0 && prev != dic[i].first) {
-      str.push_back(dic[idx].first.c_str());
-      len.push_back(dic[idx].first.size());
+    const std::pair<size_t, size_t> &k = key[dic[i]];
+    const std::pair<size_t, size_t> &p = key[dic[idx]];
+    if (i != 0 && (k.second != p.second ||
+                   std::memcmp(sbuf.data() + k.first,
+                               sbuf.data() + p.first, k.second) != 0)) {
+      str.push_back(sbuf.data() + p.first);
+      len.push_back(p.second);
       val.push_back(bsize +(idx << 8));
       bsize = 1;
       idx = i;
     } else {
       ++bsize;
     }
-    prev = dic[i].first;
   }
-  str.push_back(dic[idx].first.c_str());
-  len.push_back(dic[idx].first.size());
+  str.push_back(dic.empty() ? "" : sbuf.data() + key[dic[idx]].first);
+  len.push_back(dic.empty() ? 0 : key[dic[idx]].second);
   val.push_back(bsize +(idx << 8));
 
   CHECK_DIE(str.size() == len.size());
   CHECK_DIE(str.size() == val.size());
 
+  std::vector<std::pair<size_t, size_t> >().swap(key);
+
   Darts::DoubleArray da;
   CHECK_DIE(da.build(str.size(), const_cast<char **>(&str[0]),
-                     &len[0], &val[0], &progress_bar_darts) == 0)
+                     &len[0], &val[0],
+                     quiet ? 0 : &progress_bar_darts) == 0)
       << "unkown error in building double-array";
 
-  std::string tbuf;
-  for (size_t i = 0; i < dic.size(); ++i) {
-    tbuf.append(reinterpret_cast<const char*>(dic[i].second),
-                sizeof(Token));
-    delete dic[i].second;
-  }
-  dic.clear();
-
   // needs to be 8byte(64bit) aligned
-  while (tbuf.size() % 8 != 0) {
-    Token dummy;
-    memset(&dummy, 0, sizeof(Token));
-    tbuf.append(reinterpret_cast<const char*>(&dummy), sizeof(Token));
-  }
+  size_t tnum = token.size();
+  while ((tnum * sizeof(Token)) % 8 != 0) ++tnum;
 
   unsigned int dummy = 0;
   unsigned int lsize = matrix.left_size();
   unsigned int rsize = matrix.right_size();
   unsigned int dsize = da.unit_size() * da.size();
-  unsigned int tsize = tbuf.size();
+  unsigned int tsize = tnum * sizeof(Token);
   unsigned int fsize = fbuf.size();
 
   unsigned int version = DIC_VERSION;
@@ -343,7 +521,16 @@ bool Dictionary::compile(const Param &param,
 
   bofs.write(reinterpret_cast<const char*>(da.array()),
              da.unit_size() * da.size());
-  bofs.write(const_cast<const char *>(tbuf.data()), tbuf.size());
+
+  // tokens are written in surface order straight from |token|
+  for (size_t i = 0; i < dic.size(); ++i)
+    bofs.write(reinterpret_cast<const char*>(&token[dic[i]]), sizeof(Token));
+  for (size_t i = dic.size(); i < tnum; ++i) {
+    Token t;
+    std::memset(&t, 0, sizeof(Token));
+    bofs.write(reinterpret_cast<const char*>(&t), sizeof(Token));
+  }
+
   bofs.write(const_cast<const char *>(fbuf.data()), fbuf.size());
 
   // save magic id
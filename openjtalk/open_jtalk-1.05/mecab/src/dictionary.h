@@ -32,6 +32,7 @@ class Dictionary {
 
  public:
   typedef Darts::DoubleArray::result_pair_type result_type;
+  typedef Darts::DoubleArray::prefetch_type    prefetch_type;
 
   bool open(const char *filename,
             const char *mode = "r");
@@ -43,6 +44,14 @@ class Dictionary {
     return da_.commonPrefixSearch(key, result, rlen, len);
   }
 
+  void prefetchStart(prefetch_type *w, const char *key, size_t len) const {
+    da_.prefetchStart(w, key, len);
+  }
+
+  bool prefetchNext(prefetch_type *w) const {
+    return da_.prefetchNext(w);
+  }
+
   result_type exactMatchSearch(const char* key) {
     result_type n;
     da_.exactMatchSearch(key, n);
@@ -58,6 +67,7 @@ class Dictionary {
   }
 
   const char *filename() const { return filename_.c_str(); }
+  size_t      array_size() const { return da_.size() * da_.unit_size(); }
   const char *charset() const { return const_cast<const char*>(charset_); }
   unsigned short version() const { return version_; }
   size_t  size() const { return static_cast<size_t>(lexsize_); }
@@ -82,6 +82,8 @@ class DictionaryComplier {
       { "posid",     'p',  0,   0,   "assign Part-of-speech id" },
       { "node-format", 'F', 0,  "STR",
         "use STR as the user defined node format" },
+      { "thread",    'j',  "1", "INT",
+        "number of threads parsing the CSVs (default 1)" },
       { "version",   'v',  0,   0,   "show the version and exit."  },
       { "help",      'h',  0,   0,   "show this help and exit."  },
       { 0, 0, 0, 0 }
@@ -0,0 +1,326 @@
+//  MeCab -- Yet Another Part-of-Speech and Morphological Analyzer
+//
+//
+//  Copyright(C) 2001-2006 Taku Kudo <taku@chasen.org>
+//  Copyright(C) 2004-2006 Nippon Telegraph and Telephone Corporation
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "mecab.h"
+#include "common.h"
+#include "param.h"
+#include "scoped_ptr.h"
+#include "utils.h"
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+namespace MeCab {
+
+namespace {
+
+// connection costs are looked up as matrix[rcAttr + lsize * lcAttr], so a
+// row holds the costs from every right id to one left id. giving the most
+// frequent ids the smallest numbers packs the entries touched by common
+// transitions into a few cache lines of a few rows.
+void build_map(const std::vector<double> &freq, std::vector<int> *map) {
+  std::vector<std::pair<double, int> > order;
+  for (size_t i = 1; i < freq.size(); ++i)  // 0 is BOS/EOS and stays
+    order.push_back(std::make_pair(-freq[i], static_cast<int>(i)));
+  std::sort(order.begin(), order.end());
+  map->resize(freq.size());
+  (*map)[0] = 0;
+  for (size_t i = 0; i < order.size(); ++i)
+    (*map)[order[i].second] = static_cast<int>(i + 1);
+}
+
+void count_context(Tagger *tagger, const char *file,
+                   std::vector<double> *lfreq, std::vector<double> *rfreq) {
+  std::ifstream ifs(file);
+  CHECK_DIE(ifs) << "no such file or directory: " << file;
+  std::cout << "reading " << file << " ... " << std::flush;
+
+  std::string line;
+  size_t num = 0;
+  while (std::getline(ifs, line)) {
+    const Node *bos = tagger->parseToNode(line.c_str());
+    CHECK_DIE(bos) << tagger->what();
+    // every end node at |pos| is connected to every begin node at |pos|
+    for (size_t pos = 0; pos <= bos->sentence_length; ++pos) {
+      size_t lsize = 0;
+      size_t rsize = 0;
+      for (Node *n = bos->end_node_list[pos]; n; n = n->enext) ++lsize;
+      for (Node *n = bos->begin_node_list[pos]; n; n = n->bnext) ++rsize;
+      if (lsize == 0) continue;
+      for (Node *n = bos->end_node_list[pos]; n; n = n->enext)
+        (*rfreq)[n->rcAttr] += rsize;
+      for (Node *n = bos->begin_node_list[pos]; n; n = n->bnext)
+        (*lfreq)[n->lcAttr] += lsize;
+    }
+    ++num;
+  }
+
+  std::cout << num << std::endl;
+}
+
+void read_file(const std::string &file, std::vector<char> *buf) {
+  std::ifstream ifs(file.c_str(), std::ios::binary|std::ios::in);
+  CHECK_DIE(ifs) << "no such file or directory: " << file;
+  ifs.seekg(0, std::ios::end);
+  buf->resize(static_cast<size_t>(ifs.tellg()));
+  ifs.seekg(0, std::ios::beg);
+  if (!buf->empty()) ifs.read(&(*buf)[0], buf->size());
+  CHECK_DIE(ifs) << "cannot read: " << file;
+}
+
+void write_file(const std::string &file, const std::vector<char> &buf) {
+  std::ofstream ofs(file.c_str(), std::ios::binary|std::ios::out);
+  CHECK_DIE(ofs) << "permission denied: " << file;
+  if (!buf.empty()) ofs.write(&buf[0], buf.size());
+}
+
+bool read_lines(const std::string &file, std::vector<std::string> *lines) {
+  std::ifstream ifs(file.c_str());
+  if (!ifs) return false;
+  std::string line;
+  lines->clear();
+  while (std::getline(ifs, line)) lines->push_back(line);
+  return true;
+}
+
+void write_lines(const std::string &file,
+                 const std::vector<std::string> &lines) {
+  std::ofstream ofs(file.c_str());
+  CHECK_DIE(ofs) << "permission denied: " << file;
+  for (size_t i = 0; i < lines.size(); ++i) ofs << lines[i] << '\n';
+}
+
+int map_id(const std::vector<int> &map, long id, const std::string &file) {
+  CHECK_DIE(id >= 0 && static_cast<size_t>(id) < map.size())
+      << "context id is out of range: " << id << " in " << file;
+  return map[id];
+}
+
+std::string to_string(int val) {
+  char buf[32];
+  itoa(val, buf);
+  return std::string(buf);
+}
+
+void renumber_matrix(const std::string &ifile, const std::string &ofile,
+                     const std::vector<int> &lmap,
+                     const std::vector<int> &rmap) {
+  std::vector<char> buf;
+  read_file(ifile, &buf);
+  CHECK_DIE(buf.size() >= 2 * sizeof(short)) << "file size is invalid: "
+                                              << ifile;
+  const short *matrix = reinterpret_cast<const short *>(&buf[0]);
+  const size_t lsize = static_cast<unsigned short>(matrix[0]);
+  const size_t rsize = static_cast<unsigned short>(matrix[1]);
+  CHECK_DIE(buf.size() == (lsize * rsize + 2) * sizeof(short) &&
+            lsize == rmap.size() && rsize == lmap.size())
+      << "file size is invalid: " << ifile;
+
+  std::vector<char> out(buf);
+  short *omatrix = reinterpret_cast<short *>(&out[0]) + 2;
+  matrix += 2;
+  for (size_t r = 0; r < rsize; ++r)
+    for (size_t l = 0; l < lsize; ++l)
+      omatrix[rmap[l] + lsize * lmap[r]] = matrix[l + lsize * r];
+
+  write_file(ofile, out);
+}
+
+void renumber_matrix_def(const std::string &ifile, const std::string &ofile,
+                         const std::vector<int> &lmap,
+                         const std::vector<int> &rmap) {
+  std::vector<std::string> lines;
+  if (!read_lines(ifile, &lines)) return;
+
+  char buf[BUF_SIZE];
+  char *column[3];
+  for (size_t i = 1; i < lines.size(); ++i) {
+    if (lines[i].empty()) continue;
+    std::strncpy(buf, lines[i].c_str(), sizeof(buf) - 1);
+    buf[sizeof(buf) - 1] = '\0';
+    CHECK_DIE(tokenize2(buf, "\t ", column, 3) == 3)
+        << "format error: " << lines[i];
+    lines[i] = to_string(map_id(rmap, std::atol(column[0]), ifile)) + ' ' +
+        to_string(map_id(lmap, std::atol(column[1]), ifile)) + ' ' +
+        column[2];
+  }
+
+  write_lines(ofile, lines);
+}
+
+void renumber_dic(const std::string &ifile, const std::string &ofile,
+                  const std::vector<int> &lmap,
+                  const std::vector<int> &rmap) {
+  std::vector<char> buf;
+  read_file(ifile, &buf);
+
+  // magic, version, type, lexsize, lsize, rsize, dsize, tsize, fsize, dummy
+  unsigned int header[10];
+  CHECK_DIE(buf.size() >= sizeof(header) + 32)
+      << "dictionary file is broken: " << ifile;
+  std::memcpy(header, &buf[0], sizeof(header));
+  const size_t offset = sizeof(header) + 32 + header[6];
+  CHECK_DIE(offset + header[7] <= buf.size() &&
+            header[7] % sizeof(Token) == 0)
+      << "dictionary file is broken: " << ifile;
+
+  Token *token = reinterpret_cast<Token *>(&buf[offset]);
+  const size_t size = header[7] / sizeof(Token);
+  for (size_t i = 0; i < size; ++i) {
+    token[i].lcAttr = map_id(lmap, token[i].lcAttr, ifile);
+    token[i].rcAttr = map_id(rmap, token[i].rcAttr, ifile);
+  }
+
+  write_file(ofile, buf);
+}
+
+// "id feature" lines, written out in the order of the new ids
+void renumber_id_def(const std::string &ifile, const std::string &ofile,
+                     const std::vector<int> &map) {
+  std::vector<std::string> lines;
+  CHECK_DIE(read_lines(ifile, &lines))
+      << "no such file or directory: " << ifile;
+
+  std::vector<std::string> out(map.size());
+  for (size_t i = 0; i < lines.size(); ++i) {
+    if (lines[i].empty()) continue;
+    const size_t n = lines[i].find_first_of("\t ");
+    CHECK_DIE(n != std::string::npos) << "format error: " << lines[i];
+    const int id = map_id(map, std::atol(lines[i].c_str()), ifile);
+    out[id] = to_string(id) + lines[i].substr(n);
+  }
+
+  write_lines(ofile, out);
+}
+
+// the 2nd and 3rd columns of unk.def and of the CSV dictionaries are
+// left and right ids; -1 means that they are given by rewrite.def.
+void renumber_csv(const std::string &ifile, const std::string &ofile,
+                  const std::vector<int> &lmap,
+                  const std::vector<int> &rmap) {
+  std::vector<std::string> lines;
+  if (!read_lines(ifile, &lines)) return;
+
+  for (size_t i = 0; i < lines.size(); ++i) {
+    const std::string &line = lines[i];
+    size_t comma[3];
+    size_t n = 0;
+    bool quote = false;
+    for (size_t j = 0; j < line.size() && n < 3; ++j) {
+      if (line[j] == '"')
+        quote = !quote;
+      else if (line[j] == ',' && !quote)
+        comma[n++] = j;
+    }
+    if (n < 3) continue;
+    long lid = std::atol(line.c_str() + comma[0] + 1);
+    long rid = std::atol(line.c_str() + comma[1] + 1);
+    if (lid >= 0) lid = map_id(lmap, lid, ifile);
+    if (rid >= 0) rid = map_id(rmap, rid, ifile);
+    lines[i] = line.substr(0, comma[0] + 1) +
+        to_string(static_cast<int>(lid)) + ',' +
+        to_string(static_cast<int>(rid)) + line.substr(comma[2]);
+  }
+
+  write_lines(ofile, lines);
+}
+}
+
+class DictionaryRenumber {
+ public:
+  static int run(int argc, char **argv) {
+    static const MeCab::Option long_options[] = {
+      { "dicdir",   'd',   ".",   "DIR", "set DIR as dicdir (default \".\")" },
+      { "outdir",   'o',   ".",   "DIR",
+        "set DIR as output dir (default \".\")" },
+      { "version",   'v',  0,   0,   "show the version and exit."  },
+      { "help",      'h',  0,   0,   "show this help and exit."  },
+      { 0, 0, 0, 0 }
+    };
+
+    Param param;
+
+    if (!param.open(argc, argv, long_options)) {
+      std::cout << param.what() << "\n\n" <<  COPYRIGHT
+                << "\ntry '--help' for more information." << std::endl;
+      return -1;
+    }
+
+    if (!param.help_version()) return 0;
+
+    const std::string dicdir = param.get<std::string>("dicdir");
+    const std::string outdir = param.get<std::string>("outdir");
+    const std::vector<std::string> &corpus = param.rest_args();
+    CHECK_DIE(corpus.size()) << "no corpus is specified";
+
+#define DCONF(file) create_filename(dicdir, std::string(file))
+#define OCONF(file) create_filename(outdir, std::string(file))
+
+    std::vector<double> lfreq;
+    std::vector<double> rfreq;
+    {
+      std::vector<char> buf;
+      read_file(DCONF(MATRIX_FILE), &buf);
+      CHECK_DIE(buf.size() >= 2 * sizeof(short))
+          << "file size is invalid: " << DCONF(MATRIX_FILE);
+      const short *matrix = reinterpret_cast<const short *>(&buf[0]);
+      rfreq.resize(static_cast<unsigned short>(matrix[0]), 0.0);
+      lfreq.resize(static_cast<unsigned short>(matrix[1]), 0.0);
+    }
+
+    {
+      const char *targv[] = { "mecab", "-d", dicdir.c_str() };
+      scoped_ptr<Tagger> tagger(createTagger(3, const_cast<char **>(targv)));
+      CHECK_DIE(tagger.get()) << getTaggerError();
+      for (size_t i = 0; i < corpus.size(); ++i)
+        count_context(tagger.get(), corpus[i].c_str(), &lfreq, &rfreq);
+    }
+
+    std::vector<int> lmap;
+    std::vector<int> rmap;
+    build_map(lfreq, &lmap);
+    build_map(rfreq, &rmap);
+
+    std::cout << "emitting renumbered dictionary ..." << std::endl;
+
+    renumber_matrix(DCONF(MATRIX_FILE), OCONF(MATRIX_FILE), lmap, rmap);
+    renumber_matrix_def(DCONF(MATRIX_DEF_FILE), OCONF(MATRIX_DEF_FILE),
+                        lmap, rmap);
+    renumber_dic(DCONF(SYS_DIC_FILE), OCONF(SYS_DIC_FILE), lmap, rmap);
+    renumber_dic(DCONF(UNK_DIC_FILE), OCONF(UNK_DIC_FILE), lmap, rmap);
+    renumber_id_def(DCONF(LEFT_ID_FILE), OCONF(LEFT_ID_FILE), lmap);
+    renumber_id_def(DCONF(RIGHT_ID_FILE), OCONF(RIGHT_ID_FILE), rmap);
+    renumber_csv(DCONF(UNK_DEF_FILE), OCONF(UNK_DEF_FILE), lmap, rmap);
+
+    std::vector<std::string> dic;
+    enum_csv_dictionaries(dicdir.c_str(), &dic);
+    for (size_t i = 0; i < dic.size(); ++i) {
+      const size_t n = dic[i].find_last_of("/\\");
+      renumber_csv(dic[i], OCONF(n == std::string::npos ?
+                                 dic[i] : dic[i].substr(n + 1)),
+                   lmap, rmap);
+    }
+
+#undef DCONF
+#undef OCONF
+
+    std::cout << "\ndone!\n";
+
+    return 0;
+  }
+};
+}
+
+int mecab_dict_renumber(int argc, char **argv) {
+  return MeCab::DictionaryRenumber::run(argc, argv);
+}
@@ -75,23 +75,14 @@ void append_rewrite_rule(RewriteRules *r, char* str) {
   r->back().set_pattern(col[0], col[1]);
 }
 
-bool match_rewrite_pattern(const char *pat,
+bool match_rewrite_pattern(const std::string &pat,
+                           const std::vector<std::string> &alt,
                            const char *str) {
-  if (pat[0] == '*' || std::strcmp(pat, str) == 0)
+  if (pat[0] == '*' || pat == str)
     return true;
 
-  size_t len = std::strlen(pat);
-  if (len >= 3 && pat[0] == '(' && pat[len-1] == ')') {
-    char buf[BUF_SIZE];
-    char *col[BUF_SIZE];
-    CHECK_DIE(len < sizeof(buf) - 3) << "too long parameter";
-    std::strncpy(buf, pat + 1, BUF_SIZE);
-    buf[len-2] = '\0';
-    const size_t n = tokenize(buf, "|", col, sizeof(col));
-    CHECK_DIE(n < sizeof(col)) << "too long OR nodes";
-    for (size_t i = 0; i < n; ++i) {
-      if (std::strcmp(str, col[i]) == 0) return true;
-    }
+  for (size_t i = 0; i < alt.size(); ++i) {
+    if (alt[i] == str) return true;
   }
   return false;
 }
@@ -111,15 +102,40 @@ bool RewritePattern::set_pattern(const char *src,
   std::strncpy(buf, dst, sizeof(buf));
   tokenizeCSV(buf, back_inserter(dpat_), 512);
 
+  // OR patterns are split here once, not on every match
+  salt_.clear();
+  salt_.resize(spat_.size());
+  for (size_t i = 0; i < spat_.size(); ++i) {
+    const std::string &pat = spat_[i];
+    const size_t len = pat.size();
+    if (len >= 3 && pat[0] == '(' && pat[len-1] == ')') {
+      CHECK_DIE(len < sizeof(buf) - 3) << "too long parameter";
+      std::strncpy(buf, pat.c_str() + 1, sizeof(buf));
+      buf[len-2] = '\0';
+      tokenize(buf, "|", back_inserter(salt_[i]), BUF_SIZE);
+      CHECK_DIE(salt_[i].size() < BUF_SIZE) << "too long OR nodes";
+    }
+  }
+
   return (spat_.size() && dpat_.size());
 }
 
+bool RewritePattern::match_first(const char *str) const {
+  return spat_.empty() || match_rewrite_pattern(spat_[0], salt_[0], str);
+}
+
+void RewritePattern::first_keys(std::vector<std::string> *keys) const {
+  if (spat_.empty() || spat_[0][0] == '*') return;
+  keys->push_back(spat_[0]);
+  keys->insert(keys->end(), salt_[0].begin(), salt_[0].end());
+}
+
 bool RewritePattern::rewrite(size_t size,
                              const char **input,
                              std::string *output) const {
   if (spat_.size() > size) return false;
   for (size_t i = 0; i < spat_.size(); ++i) {
-    if (!match_rewrite_pattern(spat_[i].c_str(), input[i]))
+    if (!match_rewrite_pattern(spat_[i], salt_[i], input[i]))
       return false;
   }
 
@@ -159,11 +175,50 @@ bool RewritePattern::rewrite(size_t size,
   return true;
 }
 
+void RewriteRules::build() {
+  index_.clear();
+  any_.clear();
+
+  std::vector<std::string> keys;
+  for (size_t i = 0; i < this->size(); ++i) {
+    const size_t n = keys.size();
+    (*this)[i].first_keys(&keys);
+    if (n == keys.size()) any_.push_back(i);
+  }
+
+  for (size_t k = 0; k < keys.size(); ++k) {
+    std::vector<size_t> &cand = index_[keys[k]];
+    if (!cand.empty()) continue;
+    for (size_t i = 0; i < this->size(); ++i) {
+      if ((*this)[i].match_first(keys[k].c_str()))
+        cand.push_back(i);
+    }
+  }
+
+  indexed_ = true;
+}
+
 bool RewriteRules::rewrite(size_t size,
                            const char **input,
                            std::string *output) const {
-  for (size_t i = 0; i < this->size(); ++i) {
-    if ((*this)[i].rewrite(size, input, output))
+  if (!indexed_) {
+    for (size_t i = 0; i < this->size(); ++i) {
+      if ((*this)[i].rewrite(size, input, output))
+        return true;
+    }
+    return false;
+  }
+
+  // only the patterns whose first field can match are tried
+  const std::vector<size_t> *cand = &any_;
+  if (size > 0) {
+    std::map<std::string, std::vector<size_t> >::const_iterator it =
+        index_.find(input[0]);
+    if (it != index_.end()) cand = &it->second;
+  }
+
+  for (size_t i = 0; i < cand->size(); ++i) {
+    if ((*this)[(*cand)[i]].rewrite(size, input, output))
       return true;
   }
   return false;
@@ -196,6 +251,9 @@ bool DictionaryRewriter::open(const char *filename,
       }
     }
   }
+  unigram_rewrite_.build();
+  left_rewrite_.build();
+  right_rewrite_.build();
   return true;
 }
 
@@ -207,7 +265,7 @@ bool DictionaryRewriter::rewrite(const std::string &feature,
   char buf[BUF_SIZE];
   char *col[BUF_SIZE];
   CHECK_DIE(feature.size() < sizeof(buf) - 1) << "too long feature";
-  std::strncpy(buf, feature.c_str(), sizeof(buf) - 1);
+  std::memcpy(buf, feature.c_str(), feature.size() + 1);
   size_t n = tokenizeCSV(buf, col, sizeof(col));
   CHECK_DIE(n < sizeof(col)) << "too long CSV entities";
   return (unigram_rewrite_.rewrite(n, const_cast<const char **>(col),
@@ -248,6 +306,7 @@ bool POSIDGenerator::open(const char *filename,
               << " is not found. minimum setting is used" << std::endl;
     rewrite_.resize(1);
     rewrite_.back().set_pattern("*", "1");
+    rewrite_.build();
     return true;
   }
 
@@ -264,14 +323,16 @@ bool POSIDGenerator::open(const char *filename,
     rewrite_.resize(rewrite_.size() + 1);
     rewrite_.back().set_pattern(col[0], col[1]);
   }
+  rewrite_.build();
   return true;
 }
 
 int POSIDGenerator::id(const char *feature) const {
   char buf[BUF_SIZE];
   char *col[BUF_SIZE];
-  CHECK_DIE(std::strlen(feature) < sizeof(buf) - 1) << "too long feature";
-  std::strncpy(buf, feature, sizeof(buf) - 1);
+  const size_t len = std::strlen(feature);
+  CHECK_DIE(len < sizeof(buf) - 1) << "too long feature";
+  std::memcpy(buf, feature, len + 1);
   const size_t n = tokenizeCSV(buf, col, sizeof(col));
   CHECK_DIE(n < sizeof(col)) << "too long CSV entities";
   std::string tmp;
@@ -21,15 +21,31 @@ class RewritePattern {
  private:
   std::vector<std::string> spat_;
   std::vector<std::string> dpat_;
+  std::vector<std::vector<std::string> > salt_;  // split "(A|B|..)" of spat_
  public:
   bool set_pattern(const char *src, const char *dst);
+  bool match_first(const char *str) const;
+  void first_keys(std::vector<std::string> *keys) const;
   bool rewrite(size_t size,
                const char **input,
                std::string *output) const;
 };
 
 class RewriteRules: public std::vector<RewritePattern> {
+ private:
+  // candidate patterns, in rule order, keyed by the first field
+  std::map<std::string, std::vector<size_t> > index_;
+  std::vector<size_t> any_;
+  bool indexed_;
  public:
+  RewriteRules(): indexed_(false) {}
+  void clear() {
+    std::vector<RewritePattern>::clear();
+    index_.clear();
+    any_.clear();
+    indexed_ = false;
+  }
+  void build();
   bool rewrite(size_t size, const char **input,
                std::string *output) const;
 };
@@ -23,6 +23,14 @@ template <class T> class FreeList {
  public:
   void free() { li_ = pi_ = 0; }
 
+  // same as free(), but releases the blocks beyond the first |max|
+  void free(size_t max) {
+    free();
+    for (size_t i = max; i < freeList.size(); ++i)
+      delete [] freeList[i];
+    if (freeList.size() > max) freeList.resize(max);
+  }
+
   T* alloc() {
     if (pi_ == size) {
       li_++;
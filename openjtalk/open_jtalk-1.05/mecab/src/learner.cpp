@@ -389,13 +389,33 @@ class learner_thread: public thread {
   void run() {
     micro_p = micro_r = micro_c = err = 0;
     f = 0.0;
-    std::fill(expected.begin(), expected.end(), 0.0);
     for (size_t i = start_i; i < size; i += thread_num) {
       f += x[i]->gradient(&expected[0]);
       err += x[i]->eval(&micro_c, &micro_p, &micro_r);
     }
   }
 };
+
+// Sums the private gradients of all learner_threads over the feature
+// range [begin, end) and clears them for the next iteration, so that
+// the merge is split across threads instead of being done serially.
+// Each feature is still summed in thread order.
+class gradient_merge_thread: public thread {
+ public:
+  size_t begin;
+  size_t end;
+  std::vector<learner_thread> *learner;
+  double *expected;
+  void run() {
+    for (size_t i = 0; i < learner->size(); ++i) {
+      double *e = &(*learner)[i].expected[0];
+      for (size_t k = begin; k < end; ++k) {
+        expected[k] += e[k];
+        e[k] = 0.0;
+      }
+    }
+  }
+};
 #endif
 
 class CRFLearner {
@@ -500,14 +520,20 @@ class CRFLearner {
 
 #ifdef MECAB_USE_THREAD
     std::vector<learner_thread> thread;
+    std::vector<gradient_merge_thread> merge_thread;
     if (thread_num > 1) {
       thread.resize(thread_num);
+      merge_thread.resize(thread_num);
       for (size_t i = 0; i < thread_num; ++i) {
         thread[i].start_i = i;
         thread[i].size = x_.size();
         thread[i].thread_num = thread_num;
         thread[i].x = &x_[0];
         thread[i].expected.resize(expected.size());
+        merge_thread[i].begin = psize * i / thread_num;
+        merge_thread[i].end = psize * (i + 1) / thread_num;
+        merge_thread[i].learner = &thread;
+        merge_thread[i].expected = &expected[0];
       }
     }
 #endif
@@ -529,14 +555,18 @@ class CRFLearner {
         for (size_t i = 0; i < thread_num; ++i)
           thread[i].join();
 
+        for (size_t i = 0; i < thread_num; ++i)
+          merge_thread[i].start();
+
+        for (size_t i = 0; i < thread_num; ++i)
+          merge_thread[i].join();
+
         for (size_t i = 0; i < thread_num; ++i) {
           f += thread[i].f;
           err += thread[i].err;
           micro_r += thread[i].micro_r;
           micro_p += thread[i].micro_p;
           micro_c += thread[i].micro_c;
-          for (size_t k = 0; k < psize; ++k)
-            expected[k] += thread[i].expected[k];
         }
       }
       else
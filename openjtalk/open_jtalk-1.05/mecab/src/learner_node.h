@@ -52,8 +52,12 @@ inline bool is_empty(LearnerPath *path) {
          (!path->lnode->lpath && path->lnode->stat != MECAB_BOS_NODE) );
 }
 
-inline void calc_expectation(LearnerPath *path, double *expected, double Z) {
-  if ( is_empty(path) ) return;
+// Adds the marginal of |path| to its bigram features and returns it.
+// The unigram features of path->rnode are shared by all of its left
+// paths, so the caller sums the returned marginals and expands
+// rnode->fvector once per node instead of once per path.
+inline double calc_expectation(LearnerPath *path, double *expected, double Z) {
+  if ( is_empty(path) ) return 0.0;
 
   double c = std::exp(path->lnode->alpha +
                       path->cost +
@@ -63,11 +67,7 @@ inline void calc_expectation(LearnerPath *path, double *expected, double Z) {
     expected[*f] += c;
   }
 
-  if (path->rnode->stat != MECAB_EOS_NODE) {
-    for (const int *f = path->rnode->fvector; *f != -1; ++f) {
-      expected[*f] += c;
-    }
-  }
+  return c;
 }
 
 inline void calc_online_update(LearnerPath *path, double *expected) {
@@ -387,10 +387,16 @@ double EncoderLearnerTagger::gradient(double *expected) {
 
   double Z = beginNodeList_[len_]->alpha;  // alpha of EOS
 
-  for (int pos = 0;   pos <= static_cast<long>(len_);  ++pos)
-    for (LearnerNode *node = beginNodeList_[pos]; node; node = node->bnext)
+  for (int pos = 0;   pos <= static_cast<long>(len_);  ++pos) {
+    for (LearnerNode *node = beginNodeList_[pos]; node; node = node->bnext) {
+      double c = 0.0;
       for (LearnerPath *path = node->lpath; path; path = path->lnext)
-        calc_expectation(path, expected, Z);
+        c += calc_expectation(path, expected, Z);
+      if (c == 0.0 || node->stat == MECAB_EOS_NODE) continue;
+      for (const int *f = node->fvector; *f != -1; ++f)
+        expected[*f] += c;
+    }
+  }
 
   for (size_t i = 0; i < ans_path_list_.size(); ++i)
     Z -= ans_path_list_[i]->cost;
@@ -87,6 +87,11 @@ struct mecab_t {
   MeCab::Tagger* ptr;
 };
 
+struct mecab_model_t {
+  int allocated;
+  MeCab::Model* ptr;
+};
+
 /* for Open JTalk
 #if defined(_WIN32) && !defined(__CYGWIN__)
 HINSTANCE DllInstance = 0;
@@ -155,6 +160,85 @@ void mecab_destroy(mecab_t *c) {
   c = 0;
 }
 
+mecab_model_t* mecab_model_new(int argc, char **argv) {
+  mecab_model_t *c = new mecab_model_t;
+  MeCab::Model *ptr = MeCab::createModel(argc, argv);
+  if (!c || !ptr) {
+    delete c;
+    delete ptr;
+    setGlobalError(MeCab::getTaggerError());
+    return 0;
+  }
+  c->ptr = ptr;
+  c->allocated = LIBMECAB_ID;
+  return c;
+}
+
+mecab_model_t* mecab_model_new2(const char *arg) {
+  mecab_model_t *c = new mecab_model_t;
+  MeCab::Model *ptr = MeCab::createModel(arg);
+  if (!c || !ptr) {
+    delete c;
+    delete ptr;
+    setGlobalError(MeCab::getTaggerError());
+    return 0;
+  }
+  c->ptr = ptr;
+  c->allocated = LIBMECAB_ID;
+  return c;
+}
+
+mecab_t* mecab_model_new_tagger(mecab_model_t *m) {
+  if (!m || m->allocated != LIBMECAB_ID) {
+    setGlobalError("first argment seems invalid");
+    return 0;
+  }
+  mecab_t *c = new mecab_t;
+  MeCab::Tagger *ptr = m->ptr->createTagger();
+  if (!c || !ptr) {
+    delete c;
+    delete ptr;
+    setGlobalError(MeCab::getTaggerError());
+    return 0;
+  }
+  c->ptr = ptr;
+  c->allocated = LIBMECAB_ID;
+  return c;
+}
+
+void mecab_model_destroy(mecab_model_t *c) {
+  if (c && c->allocated) {
+    delete c->ptr;
+    delete c;
+  }
+  c = 0;
+}
+
+int mecab_model_compile_userdic(mecab_model_t *c,
+                                const char *csv, const char *dic) {
+  if (!c || c->allocated != LIBMECAB_ID) {
+    setGlobalError("first argment seems invalid");
+    return 0;
+  }
+  if (!c->ptr->compileUserDictionary(csv, dic)) {
+    setGlobalError(c->ptr->what());
+    return 0;
+  }
+  return 1;
+}
+
+int mecab_model_set_userdic(mecab_model_t *c, const char *dic) {
+  if (!c || c->allocated != LIBMECAB_ID) {
+    setGlobalError("first argment seems invalid");
+    return 0;
+  }
+  if (!c->ptr->setUserDictionary(dic)) {
+    setGlobalError(c->ptr->what());
+    return 0;
+  }
+  return 1;
+}
+
 #define MECAB_CHECK_FIRST_ARG(c, t)                     \
   if (!(c) || (c)->allocated != LIBMECAB_ID) {          \
     setGlobalError("first argment seems invalid");      \
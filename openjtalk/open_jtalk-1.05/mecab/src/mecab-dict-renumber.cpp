@@ -0,0 +1,11 @@
+//  MeCab -- Yet Another Part-of-Speech and Morphological Analyzer
+//
+//
+//  Copyright(C) 2001-2006 Taku Kudo <taku@chasen.org>
+//  Copyright(C) 2004-2006 Nippon Telegraph and Telephone Corporation
+#include "mecab.h"
+
+int main(int argc, char **argv) {
+  return mecab_dict_renumber(argc, argv);
+}
+
@@ -61,12 +61,22 @@
 #define MECAB_CPP_END
 #endif                          /* __CPLUSPLUS */
 
+#define MECAB_FEATURE_BUFF_MAX 1024      /* features kept between analyses */
+#define MECAB_TEXT_BUFF_MAX (1024 * 128) /* bytes of feature strings kept between analyses */
+
 MECAB_CPP_START;
 
 void Mecab_initialize(Mecab *m){
   m->feature = NULL;
   m->size = 0;
   m->mecab = NULL;
+  m->head = NULL;
+  m->model = NULL;
+  m->shared = 0;
+  m->feature_buff = NULL;
+  m->feature_buff_size = 0;
+  m->text_buff = NULL;
+  m->text_buff_size = 0;
 }
 
 void Mecab_load(Mecab *m, char *dicdir){
@@ -75,73 +85,156 @@ void Mecab_load(Mecab *m, char *dicdir){
 
   if(m->mecab != NULL)
     Mecab_clear(m);
-  m->mecab = mecab_new(argc,argv);
+  m->model = mecab_model_new(argc,argv);
+  if(m->model != NULL)
+    m->mecab = mecab_model_new_tagger(m->model);
   if(m->mecab == NULL){
     fprintf(stderr,"ERROR: Mecab_load() in mecab.cpp: Cannot open %s.\n",dicdir);
     exit(1);
   }
 }
 
+/* the tagger of 'm' only owns its lattice, so 'm' and 'source' can analyze in
+   different threads at the same time */
+void Mecab_load_shared(Mecab *m, Mecab *source){
+  if(m->mecab != NULL)
+    Mecab_clear(m);
+  if(source->model != NULL)
+    m->mecab = mecab_model_new_tagger(source->model);
+  if(m->mecab == NULL){
+    fprintf(stderr,"ERROR: Mecab_load_shared() in mecab.cpp: Cannot share dictionary.\n");
+    exit(1);
+  }
+  m->model = source->model;
+  m->shared = 1;
+}
+
+/* the new user dictionary is opened before the old one is released, and a
+   Mecab keeps using the old one until its next analysis */
+int Mecab_set_userdic(Mecab *m, const char *csv, const char *dic){
+  if(m->model == NULL || (csv != NULL && dic == NULL))
+    return 0;
+  if(csv != NULL && !mecab_model_compile_userdic(m->model, csv, dic)){
+    fprintf(stderr,"WARNING: Mecab_set_userdic() in mecab.cpp: Cannot compile %s. %s\n",csv,mecab_strerror(NULL));
+    return 0;
+  }
+  if(!mecab_model_set_userdic(m->model, dic)){
+    fprintf(stderr,"WARNING: Mecab_set_userdic() in mecab.cpp: Cannot attach %s. %s\n",dic != NULL ? dic : "",mecab_strerror(NULL));
+    return 0;
+  }
+  return 1;
+}
+
+/* the node list stays owned by the tagger and is valid until the next analysis */
 void Mecab_analysis(Mecab *m, char *str){
-  int i = 0;
-  mecab_node_t *head;
-  mecab_node_t *node;
+  const mecab_node_t *node;
 
-  if(m->size > 0 || m->feature != NULL)
+  if(m->size > 0 || m->feature != NULL || m->head != NULL)
     Mecab_refresh(m);
 
-  head = (mecab_node_t *) mecab_sparse_tonode(m->mecab, str);
-  if(head == NULL) return;
-  for (node = head; node != NULL; node = node->next) {
+  m->head = mecab_sparse_tonode(m->mecab, str);
+  if(m->head == NULL) return;
+  for (node = m->head; node != NULL; node = node->next) {
     if(node->stat != MECAB_BOS_NODE && node->stat != MECAB_EOS_NODE)
       m->size++;
   }
-  m->feature = (char **) calloc(m->size, sizeof(char *));
-  for (node = head; node != NULL; node = node->next) {
-    if(node->stat != MECAB_BOS_NODE && node->stat != MECAB_EOS_NODE){
-      m->feature[i] = (char *) calloc(node->length + strlen(node->feature) + 2,sizeof(char));
-      strcpy(m->feature[i],"");
-      strncat(m->feature[i],node->surface,node->length);
-      strcat(m->feature[i],",");
-      strcat(m->feature[i],node->feature);
-      i++;
-    }
-  }
 }
 
 void Mecab_print(Mecab *m){
   int i;
-  
+  char **feature = Mecab_get_feature(m);
+
   for(i = 0;i < m->size;i++)
-    printf("%s\n",m->feature[i]);
+    printf("%s\n",feature[i]);
 }
 
 int Mecab_get_size(Mecab *m){
   return m->size;
 }
 
+/* "surface,feature" strings are only built when requested, into buffers which are
+   reused by the following analyses */
 char **Mecab_get_feature(Mecab *m){
+  int i = 0;
+  int len = 0;
+  char *p;
+  const mecab_node_t *node;
+
+  if(m->feature != NULL || m->size == 0)
+    return m->feature;
+  for (node = m->head; node != NULL; node = node->next) {
+    if(node->stat != MECAB_BOS_NODE && node->stat != MECAB_EOS_NODE)
+      len += node->length + strlen(node->feature) + 2;
+  }
+  if(m->size > m->feature_buff_size){
+    free(m->feature_buff);
+    m->feature_buff = (char **) malloc(m->size * sizeof(char *));
+    m->feature_buff_size = m->size;
+  }
+  if(len > m->text_buff_size){
+    free(m->text_buff);
+    m->text_buff = (char *) malloc(len);
+    m->text_buff_size = len;
+  }
+  p = m->text_buff;
+  for (node = m->head; node != NULL; node = node->next) {
+    if(node->stat != MECAB_BOS_NODE && node->stat != MECAB_EOS_NODE){
+      m->feature_buff[i++] = p;
+      memcpy(p,node->surface,node->length);
+      p += node->length;
+      *p++ = ',';
+      len = strlen(node->feature) + 1;
+      memcpy(p,node->feature,len);
+      p += len;
+    }
+  }
+  m->feature = m->feature_buff;
   return m->feature;
 }
 
+const mecab_node_t *Mecab_get_node(Mecab *m){
+  return m->head;
+}
+
+/* the feature buffers are kept unless a long sentence grew them past the limits */
 void Mecab_refresh(Mecab *m){
-  int i;
-  
-  if(m->feature != NULL){
-    for(i = 0;i < m->size;i++)
-      free(m->feature[i]);
-    free(m->feature);
-    m->feature = NULL;
-    m->size = 0;
+  if(m->feature_buff_size > MECAB_FEATURE_BUFF_MAX){
+    free(m->feature_buff);
+    m->feature_buff = NULL;
+    m->feature_buff_size = 0;
   }
+  if(m->text_buff_size > MECAB_TEXT_BUFF_MAX){
+    free(m->text_buff);
+    m->text_buff = NULL;
+    m->text_buff_size = 0;
+  }
+  m->feature = NULL;
+  m->size = 0;
+  m->head = NULL;
 }
 
 void Mecab_clear(Mecab *m){
   Mecab_refresh(m);
+  if(m->feature_buff != NULL){
+    free(m->feature_buff);
+    m->feature_buff = NULL;
+    m->feature_buff_size = 0;
+  }
+  if(m->text_buff != NULL){
+    free(m->text_buff);
+    m->text_buff = NULL;
+    m->text_buff_size = 0;
+  }
   if(m->mecab != NULL){
     mecab_destroy(m->mecab);
     m->mecab = NULL;
   }
+  if(m->model != NULL){
+    if(!m->shared)
+      mecab_model_destroy(m->model);
+    m->model = NULL;
+    m->shared = 0;
+  }
 }
 
 MECAB_CPP_END;
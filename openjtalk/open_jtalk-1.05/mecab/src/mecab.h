@@ -184,6 +184,7 @@ extern "C" {
 #endif
 
   typedef struct mecab_t                 mecab_t;
+  typedef struct mecab_model_t           mecab_model_t;
   typedef struct mecab_dictionary_info_t mecab_dictionary_info_t;
   typedef struct mecab_node_t            mecab_node_t;
   typedef struct mecab_learner_node_t    mecab_learner_node_t;
@@ -201,6 +202,18 @@ extern "C" {
   MECAB_DLL_EXTERN const char*   mecab_strerror(mecab_t *mecab);
   MECAB_DLL_EXTERN void          mecab_destroy(mecab_t *mecab);
 
+  /* a model holds the read-only dictionaries and connection costs; taggers
+     created from one model may run in different threads concurrently */
+  MECAB_DLL_EXTERN mecab_model_t* mecab_model_new(int argc, char **argv);
+  MECAB_DLL_EXTERN mecab_model_t* mecab_model_new2(const char *arg);
+  MECAB_DLL_EXTERN mecab_t*      mecab_model_new_tagger(mecab_model_t *model);
+  MECAB_DLL_EXTERN void          mecab_model_destroy(mecab_model_t *model);
+  MECAB_DLL_EXTERN int           mecab_model_compile_userdic(mecab_model_t *model,
+                                                             const char *csv,
+                                                             const char *dic);
+  MECAB_DLL_EXTERN int           mecab_model_set_userdic(mecab_model_t *model,
+                                                         const char *dic);
+
   MECAB_DLL_EXTERN int           mecab_get_partial(mecab_t *mecab);
   MECAB_DLL_EXTERN void          mecab_set_partial(mecab_t *mecab, int partial);
   MECAB_DLL_EXTERN float         mecab_get_theta(mecab_t *mecab);
@@ -230,6 +243,7 @@ extern "C" {
   MECAB_DLL_EXTERN const char*   mecab_format_node(mecab_t *mecab, const mecab_node_t *node);
   MECAB_DLL_EXTERN const mecab_dictionary_info_t* mecab_dictionary_info(mecab_t *mecab);
   MECAB_DLL_EXTERN int           mecab_dict_index(int argc, char **argv);
+  MECAB_DLL_EXTERN int           mecab_dict_renumber(int argc, char **argv);
   MECAB_DLL_EXTERN int           mecab_dict_gen(int argc, char **argv);
   MECAB_DLL_EXTERN int           mecab_cost_train(int argc, char **argv);
   MECAB_DLL_EXTERN int           mecab_system_eval(int argc, char **argv);
@@ -301,9 +315,41 @@ class Tagger {
   static const char *version();
 };
 
+class Model {
+ public:
+  // taggers share the dictionaries of this model and keep their own
+  // lattice, so each of them can be used from its own thread.
+  // the model must outlive every tagger created from it.
+  virtual Tagger* createTagger() const = 0;
+
+  virtual const DictionaryInfo* dictionary_info() const = 0;
+
+  // compiles |csv|, a word list in the format of mecab-dict-index and in
+  // the charset of the system dictionary, into the user dictionary |dic|.
+  // context ids given as -1 are assigned with the rewrite rules found in
+  // the dictionary directory.
+  virtual bool compileUserDictionary(const char *csv, const char *dic) = 0;
+
+  // attaches the user dictionary |dic| in place of the current one, or
+  // detaches it when |dic| is 0. taggers of this model pick the change up
+  // at their next parse, while the system dictionary stays mapped.
+  virtual bool setUserDictionary(const char *dic) = 0;
+
+  virtual const char* what() = 0;
+
+  virtual ~Model() {}
+
+#ifndef SIWG
+  static Model* create(int argc, char **argv);
+  static Model* create(const char *arg);
+#endif
+};
+
 /* factory method */
 MECAB_DLL_EXTERN Tagger *createTagger(int argc, char **argv);
 MECAB_DLL_EXTERN Tagger *createTagger(const char *arg);
+MECAB_DLL_EXTERN Model  *createModel(int argc, char **argv);
+MECAB_DLL_EXTERN Model  *createModel(const char *arg);
 MECAB_DLL_EXTERN const char* getTaggerError();
 }
 
@@ -327,14 +373,30 @@ typedef struct _Mecab{
    char **feature;
    int size;
    mecab_t *mecab;
+   const mecab_node_t *head;
+   mecab_model_t *model;
+   int shared;                  /* model is owned by another Mecab */
+   char **feature_buff;         /* kept across analyses */
+   int feature_buff_size;
+   char *text_buff;             /* storage of feature strings */
+   int text_buff_size;
 } Mecab;
 
 void Mecab_initialize(Mecab *m);
 void Mecab_load(Mecab *m, char *dicdir);
+/* share the dictionary of 'source' which must be cleared after 'm'. 'm' and
+   'source' may analyze in different threads, each feeding its own NJD and
+   JPCommon; the tables shared by the front end are built once under a guard */
+void Mecab_load_shared(Mecab *m, Mecab *source);
+/* compile the word list 'csv' into the user dictionary 'dic' and attach it to
+   the dictionary of 'm' and of every Mecab sharing it; 'csv' may be NULL to
+   attach a compiled 'dic', and 'dic' NULL to detach. returns 0 on failure */
+int Mecab_set_userdic(Mecab *m, const char *csv, const char *dic);
 void Mecab_analysis(Mecab *m, char *str);
 void Mecab_print(Mecab *m);
 int Mecab_get_size(Mecab *m);
 char **Mecab_get_feature(Mecab *m);
+const mecab_node_t *Mecab_get_node(Mecab *m);
 void Mecab_refresh(Mecab *m);
 void Mecab_clear(Mecab *m);
 
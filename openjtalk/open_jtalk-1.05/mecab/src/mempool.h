@@ -72,6 +72,13 @@
     pool__.release(map);                                \
     map = 0; } while (0)
 
+// drops the shared mapping of |file| from the pool so that the next
+// MMAP_OPEN maps the file afresh; existing holders keep the old one.
+#define MMAP_FORGET(type, file) do {                    \
+    MemoryPool<std::string, Mmap<type> >& pool__ =      \
+        getMemoryPool<std::string, Mmap<type> >();      \
+    pool__.forget(file); } while (0)
+
 namespace MeCab {
 
 template <typename _Key, typename _Value> class MemoryPool {
@@ -117,6 +124,12 @@ template <typename _Key, typename _Value> class MemoryPool {
     return m;
   }
 
+  void forget(const key_type &key) {
+    mutex_.lock();
+    pool_.erase(key);
+    mutex_.unlock();
+  }
+
   void release(value_type *m = 0) {
     mutex_.lock();
 
@@ -128,7 +141,8 @@ template <typename _Key, typename _Value> class MemoryPool {
         if (it->second.second == 0) {
           typename std::map<_Key, _Value*>::iterator it2 =
               pool_.find(it->second.first);
-          pool_.erase(it2);
+          if (it2 != pool_.end() && it2->second == m)
+            pool_.erase(it2);
           rpool_.erase(it);
           delete m;
           m = 0;
@@ -162,5 +176,7 @@ getMemoryPool() {
 #define MMAP_CLOSE(type, map) do {              \
     if(map) delete map; map = NULL; } while (0)
 
+#define MMAP_FORGET(type, file) do { } while (0)
+
 #endif
 #endif
@@ -3,7 +3,9 @@
 //
 //  Copyright(C) 2001-2006 Taku Kudo <taku@chasen.org>
 //  Copyright(C) 2004-2006 Nippon Telegraph and Telephone Corporation
+#include <cstdio>
 #include <cstring>
+#include <fstream>
 #include <iostream>
 
 #include "viterbi.h"
@@ -15,6 +17,12 @@
 #include "connector.h"
 #include "nbest_generator.h"
 #include "stream_wrapper.h"
+#include "mutex.h"
+#include "mmap.h"
+#include "mempool.h"
+#include "utils.h"
+#include "dictionary_rewriter.h"
+#include "context_id.h"
 
 #ifdef HAVE_CONFIG_H
 #include "config.h"
@@ -69,6 +77,48 @@ const MeCab::Option long_options[] = {
 }
 
 namespace MeCab {
+// a user dictionary attached to a model. taggers may still be reading it
+// after it is replaced, so it is closed when the last reference goes.
+struct UserDictionary {
+  Dictionary dic;
+  size_t     refs;
+  UserDictionary(): refs(1) {}
+};
+
+class ModelImpl: public Model {
+ private:
+  scoped_ptr<Param>          param_;
+  Tokenizer                  tokenizer_;
+  Connector                  connector_;
+  UserDictionary            *userdic_;
+  mutable Mutex              mutex_;
+  whatlog                    what_;
+
+  bool                  open(Param *);
+
+ public:
+  bool                  open(int, char**);
+  bool                  open(const char*);
+  void                  close();
+  Tagger*               createTagger() const;
+  const DictionaryInfo *dictionary_info() const;
+  bool                  compileUserDictionary(const char *, const char *);
+  bool                  setUserDictionary(const char *);
+  const char*           what();
+
+  // makes |*userdic| the attached user dictionary, moving the reference
+  // held on the previous one. returns false when it was already.
+  bool                  update(UserDictionary **userdic) const;
+  void                  release(UserDictionary *userdic) const;
+
+  const Param          &param() const { return *param_; }
+  const Tokenizer      &tokenizer() const { return tokenizer_; }
+  const Connector      &connector() const { return connector_; }
+
+  ModelImpl(): userdic_(0) {}
+  virtual ~ModelImpl() { this->close(); }
+};
+
 class TaggerImpl: public Tagger {
  private:
   Tokenizer                  tokenizer_;
@@ -78,12 +128,15 @@ class TaggerImpl: public Tagger {
   Writer                     writer_;
   scoped_ptr<NBestGenerator> nbest_;
   const char*                begin_;
+  const ModelImpl           *model_;
+  UserDictionary            *userdic_;
   whatlog                    what_;
 
  public:
   bool                  open(Param *);
   bool                  open(int, char**);
   bool                  open(const char*);
+  bool                  open(const ModelImpl &);
   void                  close();
   const char*           parse(const char*);
   const char*           parse(const char*, size_t);
@@ -112,7 +165,7 @@ class TaggerImpl: public Tagger {
   bool                  all_morphs() const;
   const char*           what();
 
-  TaggerImpl() {}
+  TaggerImpl(): begin_(0), model_(0), userdic_(0) {}
   virtual ~TaggerImpl() { this->close(); }
 };
 
@@ -167,7 +220,252 @@ bool TaggerImpl::open(Param *param) {
   return true;
 }
 
-void TaggerImpl::close() {}
+bool TaggerImpl::open(const ModelImpl &model) {
+  close();
+
+  const Param &param = model.param();
+
+  CHECK_CLOSE_FALSE(tokenizer_.open(model.tokenizer())) << tokenizer_.what();
+  CHECK_CLOSE_FALSE(viterbi_.open(param, &tokenizer_, &model.connector()))
+      << viterbi_.what();
+  CHECK_CLOSE_FALSE(writer_.open(param)) << writer_.what();
+
+  if (param.get<std::string>("output-format-type") == "dump") {
+    set_lattice_level(3);
+    set_all_morphs(true);
+  }
+
+  model_ = &model;
+
+  return true;
+}
+
+void TaggerImpl::close() {
+  if (model_) {
+    tokenizer_.attach(0);
+    model_->release(userdic_);
+  }
+  model_ = 0;
+  userdic_ = 0;
+}
+
+const char *ModelImpl::what() {
+  return what_.str();
+}
+
+bool ModelImpl::open(int argc, char **argv) {
+  Param *param = new Param;
+  param_.reset(param);
+  CHECK_CLOSE_FALSE(param->open(argc, argv, long_options)) << param->what();
+  return open(param);
+}
+
+bool ModelImpl::open(const char *arg) {
+  Param *param = new Param;
+  param_.reset(param);
+  CHECK_CLOSE_FALSE(param->open(arg, long_options)) << param->what();
+  return open(param);
+}
+
+bool ModelImpl::open(Param *param) {
+  if (param->get<bool>("help")) {
+    WHAT << param->help();
+    close();
+    return false;
+  }
+
+  if (param->get<bool>("version")) {
+    WHAT << param->version();
+    close();
+    return false;
+  }
+
+  CHECK_CLOSE_FALSE(load_dictionary_resource(param)) << param->what();
+
+  CHECK_CLOSE_FALSE(tokenizer_.open(*param)) << tokenizer_.what();
+  CHECK_CLOSE_FALSE(connector_.open(*param)) << connector_.what();
+
+#if defined(_WIN32) && !defined(__CYGWIN__)
+  std::locale::global(std::locale("C"));
+#endif
+
+  return true;
+}
+
+void ModelImpl::close() {
+  release(userdic_);
+  userdic_ = 0;
+  tokenizer_.close();
+  connector_.close();
+}
+
+bool ModelImpl::compileUserDictionary(const char *csv, const char *dic) {
+  what_.stream_.str("");  // may be called many times on a live model
+  CHECK_FALSE(csv && dic) << "NULL pointer is given";
+  const Dictionary *sysdic = tokenizer_.system_dictionary();
+  CHECK_FALSE(sysdic) << "model is not opened";
+
+  const std::string dicdir = param_->get<std::string>("dicdir");
+  const std::string tmp = std::string(dic) + ".tmp";
+
+  // the word list is checked here first so that malformed entries are
+  // reported with the line they are found on.
+  {
+    std::ifstream ifs(csv);
+    CHECK_FALSE(ifs) << "no such file or directory: " << csv;
+    scoped_ptr<DictionaryRewriter> rewrite(0);
+    scoped_ptr<ContextID> cid(0);
+    std::string str, ufeature, lfeature, rfeature;
+    char line[BUF_SIZE];
+    while (std::getline(ifs, str)) {
+      // Dictionary::compile() reads at most BUF_SIZE - 1 bytes per line
+      CHECK_FALSE(str.size() < sizeof(line))
+          << "too long line (" << str.size() << " bytes) in " << csv;
+      std::strcpy(line, str.c_str());
+      char *col[8];
+      CHECK_FALSE(tokenizeCSV(line, col, 5) == 5)
+          << "format error: " << line;
+      CHECK_FALSE(*col[0]) << "empty word is found";
+      const int lid = std::atoi(col[1]);
+      const int rid = std::atoi(col[2]);
+      if (lid >= 0 && rid >= 0) {
+        CHECK_FALSE(static_cast<size_t>(lid) < connector_.left_size() &&
+                    static_cast<size_t>(rid) < connector_.right_size())
+            << "invalid ids are found lid=" << lid << " rid=" << rid;
+        continue;
+      }
+      if (!rewrite.get()) {
+        const char *files[] = { REWRITE_FILE, LEFT_ID_FILE, RIGHT_ID_FILE };
+        for (size_t i = 0; i < 3; ++i) {
+          const std::string file = create_filename(dicdir, files[i]);
+          std::ifstream ifs2(file.c_str());
+          CHECK_FALSE(ifs2) << "no such file or directory: " << file;
+        }
+        rewrite.reset(new DictionaryRewriter);
+        rewrite->open(create_filename(dicdir, REWRITE_FILE).c_str());
+        cid.reset(new ContextID);
+        cid->open(create_filename(dicdir, LEFT_ID_FILE).c_str(),
+                  create_filename(dicdir, RIGHT_ID_FILE).c_str());
+      }
+      CHECK_FALSE(rewrite->rewrite(col[4], &ufeature,
+                                   &lfeature, &rfeature) &&
+                  cid->left_ids().count(lfeature) &&
+                  cid->right_ids().count(rfeature))
+          << "no context id is found for " << col[4];
+    }
+    std::ofstream ofs(tmp.c_str());
+    CHECK_FALSE(ofs) << "permission denied: " << tmp;
+  }
+
+  Param param;
+  param.set("dictionary-charset", sysdic->charset());
+  param.set("charset", sysdic->charset());
+  param.set("type", static_cast<int>(MECAB_USR_DIC));
+  param.set("quiet", 1);  // the caller's stdout is not ours to write to
+
+  std::vector<std::string> dics;
+  dics.push_back(csv);
+
+  // errors which slip through the check above must not bring down a
+  // running process, so CHECK_DIE throws while |trap| lives.
+  std::string error;
+  {
+    die_trap trap;
+    try {
+#define DCONF(file) create_filename(dicdir, std::string(file)).c_str()
+      Dictionary::compile(param, dics,
+                          DCONF(MATRIX_DEF_FILE),
+                          DCONF(MATRIX_FILE),
+                          DCONF(LEFT_ID_FILE),
+                          DCONF(RIGHT_ID_FILE),
+                          DCONF(REWRITE_FILE),
+                          DCONF(POS_ID_FILE),
+                          tmp.c_str());
+#undef DCONF
+    } catch (const die_error &) {
+      error = trap.stream_.str();
+      if (error.empty()) error = "cannot compile " + std::string(csv);
+      std::remove(tmp.c_str());
+    }
+  }
+  CHECK_FALSE(error.empty()) << error;
+
+  // taggers may have |dic| mapped, so it is replaced, not overwritten
+  CHECK_FALSE(std::rename(tmp.c_str(), dic) == 0)
+      << "cannot rename " << tmp << " to " << dic;
+
+  return true;
+}
+
+bool ModelImpl::setUserDictionary(const char *dic) {
+  UserDictionary *userdic = 0;
+  what_.stream_.str("");
+
+  if (dic) {
+    const Dictionary *sysdic = tokenizer_.system_dictionary();
+    CHECK_FALSE(sysdic) << "model is not opened";
+    // the file may have been replaced since it was last mapped
+    MMAP_FORGET(char, std::string(dic));
+    userdic = new UserDictionary;
+    if (!userdic->dic.open(dic)) {
+      WHAT << userdic->dic.what();
+      delete userdic;
+      return false;
+    }
+    if (userdic->dic.type() != MECAB_USR_DIC ||
+        !sysdic->isCompatible(userdic->dic)) {
+      WHAT << "incompatible user dictionary: " << dic;
+      delete userdic;
+      return false;
+    }
+  }
+
+  mutex_.lock();
+  UserDictionary *old = userdic_;
+  userdic_ = userdic;
+  mutex_.unlock();
+
+  release(old);
+
+  return true;
+}
+
+bool ModelImpl::update(UserDictionary **userdic) const {
+  mutex_.lock();
+  UserDictionary *old = *userdic;
+  const bool changed = old != userdic_;
+  if (changed) {
+    *userdic = userdic_;
+    if (userdic_) ++userdic_->refs;
+  }
+  mutex_.unlock();
+
+  if (changed) release(old);
+
+  return changed;
+}
+
+void ModelImpl::release(UserDictionary *userdic) const {
+  if (!userdic) return;
+  mutex_.lock();
+  const bool last = --userdic->refs == 0;
+  mutex_.unlock();
+  if (last) delete userdic;
+}
+
+Tagger *ModelImpl::createTagger() const {
+  TaggerImpl *tagger = new TaggerImpl();
+  if (!tagger->open(*this)) {
+    setGlobalError(tagger->what());
+    delete tagger;
+    return 0;
+  }
+  return tagger;
+}
+
+const DictionaryInfo *ModelImpl::dictionary_info() const {
+  return tokenizer_.dictionary_info();
+}
 
 void TaggerImpl::set_partial(bool partial) {
   viterbi_.set_partial(partial);
@@ -251,6 +549,8 @@ const Node *TaggerImpl::parseToNode(const char *str) {
 
 const Node *TaggerImpl::parseToNode(const char *str, size_t len) {
   CHECK_RETURN(str, static_cast<Node *>(0)) << "NULL pointer is given";
+  if (model_ && model_->update(&userdic_))
+    tokenizer_.attach(userdic_ ? &userdic_->dic : 0);
   const Node *bosNode = viterbi_.analyze(str, len);
   CHECK_RETURN(bosNode, static_cast<const Node *>(0)) << viterbi_.what();
   return bosNode;
@@ -384,6 +684,34 @@ Tagger *createTagger(const char *argv) {
   return tagger;
 }
 
+Model *Model::create(int argc, char **argv) {
+  return createModel(argc, argv);
+}
+
+Model *Model::create(const char *arg) {
+  return createModel(arg);
+}
+
+Model *createModel(int argc, char **argv) {
+  ModelImpl *model = new ModelImpl();
+  if (!model->open(argc, argv)) {
+    setGlobalError(model->what());
+    delete model;
+    return 0;
+  }
+  return model;
+}
+
+Model *createModel(const char *arg) {
+  ModelImpl *model = new ModelImpl();
+  if (!model->open(arg)) {
+    setGlobalError(model->what());
+    delete model;
+    return 0;
+  }
+  return model;
+}
+
 const char *getTaggerError() {
   return getGlobalError();
 }
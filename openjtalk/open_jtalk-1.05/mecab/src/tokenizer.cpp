@@ -54,6 +54,8 @@ template Node* TokenizerImpl<Node, Path>::getBOSNode();
 template Node* TokenizerImpl<Node, Path>::getEOSNode();
 template Node* TokenizerImpl<Node, Path>::lookup(const char*, const char*);
 template bool TokenizerImpl<Node, Path>::open(const Param &);
+template bool TokenizerImpl<Node, Path>::open(const TokenizerImpl<Node, Path> &);
+template void TokenizerImpl<Node, Path>::attach(Dictionary *);
 template TokenizerImpl<LearnerNode, LearnerPath>::TokenizerImpl();
 template void TokenizerImpl<LearnerNode, LearnerPath>::clear();
 template void TokenizerImpl<LearnerNode, LearnerPath>::close();
@@ -64,18 +66,26 @@ template LearnerNode* TokenizerImpl<LearnerNode, LearnerPath>::getBOSNode();
 template LearnerNode*
 TokenizerImpl<LearnerNode, LearnerPath>::lookup(const char*, const char*);
 template bool TokenizerImpl<LearnerNode, LearnerPath>::open(const Param &);
+template bool TokenizerImpl<LearnerNode, LearnerPath>::open
+(const TokenizerImpl<LearnerNode, LearnerPath> &);
+template void TokenizerImpl<LearnerNode, LearnerPath>::attach(Dictionary *);
 #endif
 
 template <typename N, typename P>
 TokenizerImpl<N, P>::TokenizerImpl():
+    open_size_(0), unkdic_(0),
     node_freelist_(NODE_FREELIST_SIZE),
     dictionary_info_freelist_(4),
     daresults_(new Dictionary::result_type[DRESULT_SIZE]),
-    dictionary_info_(0), max_grouping_size_(0), id_(0) {}
+    prefetch_pos_(0), prefetch_slot_(0), char_begin_(0), char_end_(0),
+    dictionary_info_(0), property_(0),
+    max_grouping_size_(0), id_(0), shared_(false) {}
 
 template <typename N, typename P>
 void TokenizerImpl<N, P>::clear() {
-  node_freelist_.free();
+  node_freelist_.free(NODE_FREELIST_MAX);
+  prefetch_pos_ = 0;
+  char_begin_ = char_end_ = 0;
   id_ = 0;
 }
 
@@ -107,10 +117,13 @@ bool TokenizerImpl<N, P>::open(const Param &param) {
   const char *mode = param.template get<bool>("open-mutable-dictionary") ?
       "r+" : "r";
 
-  CHECK_CLOSE_FALSE(unkdic_.open(create_filename
-                                 (prefix, UNK_DIC_FILE).c_str(), mode))
-      << unkdic_.what();
-  CHECK_CLOSE_FALSE(property_.open(param)) << property_.what();
+  unkdic_ = new Dictionary;
+  property_ = new CharProperty;
+
+  CHECK_CLOSE_FALSE(unkdic_->open(create_filename
+                                  (prefix, UNK_DIC_FILE).c_str(), mode))
+      << unkdic_->what();
+  CHECK_CLOSE_FALSE(property_->open(param)) << property_->what();
 
   Dictionary *sysdic = new Dictionary;
 
@@ -121,7 +134,7 @@ bool TokenizerImpl<N, P>::open(const Param &param) {
   CHECK_CLOSE_FALSE(sysdic->type() == 0)
       << "not a system dictionary: " << prefix;
 
-  property_.set_charset(sysdic->charset());
+  property_->set_charset(sysdic->charset());
   dic_.push_back(sysdic);
 
   const std::string userdic = param.template get<std::string>("userdic");
@@ -157,16 +170,16 @@ bool TokenizerImpl<N, P>::open(const Param &param) {
   }
 
   unk_tokens_.clear();
-  for (size_t i = 0; i < property_.size(); ++i) {
-    const char *key = property_.name(i);
-    Dictionary::result_type n = unkdic_.exactMatchSearch(key);
+  for (size_t i = 0; i < property_->size(); ++i) {
+    const char *key = property_->name(i);
+    Dictionary::result_type n = unkdic_->exactMatchSearch(key);
     CHECK_CLOSE_FALSE(n.value != -1) << "cannot find UNK category: " << key;
-    const Token *token = unkdic_.token(n);
-    size_t size  = unkdic_.token_size(n);
+    const Token *token = unkdic_->token(n);
+    size_t size  = unkdic_->token_size(n);
     unk_tokens_.push_back(std::make_pair(token, size));
   }
 
-  space_ = property_.getCharInfo(0x20);  // ad-hoc
+  space_ = property_->getCharInfo(0x20);  // ad-hoc
 
   bos_feature_.reset_string(param.template get<std::string>("bos-feature"));
 
@@ -181,15 +194,151 @@ bool TokenizerImpl<N, P>::open(const Param &param) {
   if (max_grouping_size_ == 0)
     max_grouping_size_ = DEFAULT_MAX_GROUPING_SIZE;
 
+  open_size_ = dic_.size();
+  initPrefetch();
+
+  return true;
+}
+
+template <typename N, typename P>
+bool TokenizerImpl<N, P>::open(const TokenizerImpl<N, P> &model) {
+  close();
+
+  CHECK_CLOSE_FALSE(model.unkdic_ && model.property_)
+      << "model tokenizer is not opened";
+
+  dic_               = model.dic_;
+  unkdic_            = model.unkdic_;
+  property_          = model.property_;
+  unk_tokens_        = model.unk_tokens_;
+  dictionary_info_   = model.dictionary_info_;
+  space_             = model.space_;
+  max_grouping_size_ = model.max_grouping_size_;
+  shared_            = true;
+
+  bos_feature_.reset_string(model.bos_feature_.get());
+  unk_feature_.reset(0);
+  if (model.unk_feature_.get())
+    unk_feature_.reset_string(model.unk_feature_.get());
+
+  open_size_ = dic_.size();
+  initPrefetch();
+
   return true;
 }
 
+template <typename N, typename P>
+void TokenizerImpl<N, P>::attach(Dictionary *userdic) {
+  dic_.resize(open_size_);
+  if (userdic) dic_.push_back(userdic);
+  initPrefetch();
+}
+
+template <typename N, typename P>
+void TokenizerImpl<N, P>::initPrefetch() {
+  size_t array_size = 0;
+  for (size_t i = 0; i < dic_.size(); ++i)
+    array_size += dic_[i]->array_size();
+  prefetch_.clear();
+  if (array_size >= LOOKUP_PREFETCH_MIN)
+    prefetch_.resize(LOOKUP_PREFETCH_SIZE * dic_.size());
+  prefetch_pos_ = 0;
+}
+
+// keeps one walk per dictionary for each of the LOOKUP_PREFETCH_SIZE
+// characters following |begin| and moves every walk LOOKUP_PREFETCH_STEP
+// units deeper, so that the double-array units lookup() reads there are
+// already in cache when it gets to them.
+template <typename N, typename P>
+void TokenizerImpl<N, P>::prefetch(const char *begin, const char *end) {
+  const size_t dsize = dic_.size();
+  size_t starts = 1;
+  if (!prefetch_pos_ || prefetch_pos_ <= begin) {
+    // first lookup of the sentence, or one that skipped past every walk
+    for (size_t i = 0; i < prefetch_.size(); ++i) prefetch_[i].len = 0;
+    prefetch_pos_ = begin;
+    prefetch_slot_ = 0;
+    starts = LOOKUP_PREFETCH_SIZE;
+  }
+
+  for (; starts > 0 && prefetch_pos_ < end; --starts) {
+    size_t mblen = 0;
+    getCharInfo(prefetch_pos_, end, &mblen);
+    prefetch_pos_ += mblen ? mblen : 1;
+    if (prefetch_pos_ >= end) break;
+    Dictionary::prefetch_type *w = &prefetch_[prefetch_slot_ * dsize];
+    for (size_t i = 0; i < dsize; ++i)
+      dic_[i]->prefetchStart(&w[i], prefetch_pos_,
+                             static_cast<size_t>(end - prefetch_pos_));
+    if (++prefetch_slot_ == LOOKUP_PREFETCH_SIZE) prefetch_slot_ = 0;
+  }
+
+  for (size_t step = 0; step < LOOKUP_PREFETCH_STEP; ++step)
+    for (size_t k = 0; k < LOOKUP_PREFETCH_SIZE; ++k)
+      for (size_t i = 0; i < dsize; ++i)
+        dic_[i]->prefetchNext(&prefetch_[k * dsize + i]);
+}
+
+// decodes the sentence once, so that lookup() reads character classes
+// and unknown-word runs from a table instead of re-scanning a long run of
+// ASCII, digits or katakana from each of its start positions.
+template <typename N, typename P>
+void TokenizerImpl<N, P>::buildCharRuns(const char *begin, const char *end) {
+  const size_t len = static_cast<size_t>(end - begin);
+  char_runs_.resize(len);
+
+  for (size_t i = 0; i < len;) {
+    size_t mblen = 0;
+    CharRun &r = char_runs_[i];
+    r.info = property_->getCharInfo(begin + i, end, &mblen);
+    r.mblen = static_cast<unsigned short>(mblen);
+    for (size_t j = i + 1; j < i + mblen && j < len; ++j)
+      char_runs_[j].mblen = 0;
+    i += mblen ? mblen : 1;
+  }
+
+  // the run after a character goes on while each character is of a kind
+  // with the one before it, as in CharProperty::seekToOtherType()
+  for (size_t i = len; i-- > 0;) {
+    CharRun &r = char_runs_[i];
+    if (!r.mblen) continue;
+    const size_t next = i + r.mblen;
+    if (next < len && r.info.isKindOf(char_runs_[next].info)) {
+      r.run_end = char_runs_[next].run_end;
+      r.run_len = char_runs_[next].run_len + 1;
+    } else {
+      r.run_end = static_cast<unsigned short>(next);
+      r.run_len = 0;
+    }
+  }
+
+  char_begin_ = begin;
+  char_end_ = end;
+}
+
+// returns the end of the run following the character of class |c| and
+// length |mblen| at |begin|
+template <typename N, typename P>
+const char *TokenizerImpl<N, P>::seekRun(const char *begin, const char *end,
+                                         const CharInfo &c, size_t mblen,
+                                         size_t *clen) const {
+  if (end == char_end_ && begin >= char_begin_ && begin < char_end_) {
+    const CharRun &r = char_runs_[begin - char_begin_];
+    if (r.mblen) {
+      *clen = r.run_len;
+      return char_begin_ + r.run_end;
+    }
+  }
+  CharInfo fail;
+  return seekToOtherType(begin + mblen, end, c, &fail, &mblen, clen);
+}
+
 #define ADDUNKNWON do {                                                 \
     const Token  *token = unk_tokens_[cinfo.default_type].first;        \
     size_t size   = unk_tokens_[cinfo.default_type].second;             \
     for (size_t k = 0; k < size; ++k) {                                 \
       N *newNode = getNewNode();                                        \
-      read_node_info(unkdic_, *(token + k), &newNode);                  \
+      read_node_info(*unkdic_, *(token + k), &newNode);                 \
       newNode->token = (Token *)(token + k);                            \
       newNode->id = id_ - 1;                                            \
       newNode->char_type = cinfo.default_type;                          \
@@ -208,9 +357,15 @@ N *TokenizerImpl<N, P>::lookup(const char *begin, const char *end) {
   size_t mblen = 0;
   size_t clen = 0;
 
-  end = static_cast<size_t>(end - begin) >= 65535 ? begin + 65535 : end;
-  const char *begin2 = property_.seekToOtherType(begin, end, space_,
-                                                 &cinfo, &mblen, &clen);
+  if (static_cast<size_t>(end - begin) >= 65535)
+    end = begin + 65535;
+  else if (end != char_end_ || begin < char_begin_)
+    buildCharRuns(begin, end);
+
+  const char *begin2 = seekToOtherType(begin, end, space_,
+                                       &cinfo, &mblen, &clen);
+
+  if (!prefetch_.empty()) prefetch(begin2, end);
 
   for (std::vector<Dictionary *>::const_iterator it = dic_.begin();
        it != dic_.end(); ++it) {
@@ -248,9 +403,7 @@ N *TokenizerImpl<N, P>::lookup(const char *begin, const char *end) {
 
   if (cinfo.group) {
     const char *tmp = begin3;
-    CharInfo fail;
-    begin3 = property_.seekToOtherType(begin3, end, cinfo,
-                                       &fail, &mblen, &clen);
+    begin3 = seekRun(begin2, end, cinfo, mblen, &clen);
     if (clen <= max_grouping_size_) ADDUNKNWON;
     group_begin3 = begin3;
     begin3 = tmp;
@@ -261,7 +414,7 @@ N *TokenizerImpl<N, P>::lookup(const char *begin, const char *end) {
     if (begin3 == group_begin3) continue;
     clen = i;
     ADDUNKNWON;
-    if (!cinfo.isKindOf(property_.getCharInfo(begin3, end, &mblen))) break;
+    if (!cinfo.isKindOf(getCharInfo(begin3, end, &mblen))) break;
     begin3 += mblen;
   }
 
@@ -279,11 +432,21 @@ const DictionaryInfo *TokenizerImpl<N, P>::dictionary_info() const {
 
 template <typename N, typename P>
 void TokenizerImpl<N, P>::close() {
-  for (std::vector<Dictionary *>::iterator it = dic_.begin();
-       it != dic_.end(); ++it)
-    delete *it;
+  if (!shared_) {
+    for (std::vector<Dictionary *>::iterator it = dic_.begin();
+         it != dic_.end(); ++it)
+      delete *it;
+    delete unkdic_;
+    delete property_;
+  }
   dic_.clear();
+  open_size_ = 0;
+  prefetch_.clear();
   unk_tokens_.clear();
-  property_.close();
+  char_begin_ = char_end_ = 0;
+  unkdic_ = 0;
+  property_ = 0;
+  dictionary_info_ = 0;
+  shared_ = false;
 }
 }
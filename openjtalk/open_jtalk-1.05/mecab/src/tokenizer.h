@@ -20,21 +20,69 @@ class Param;
 template <typename N, typename P>
 class TokenizerImpl {
  private:
+  // character class of one byte offset of the sentence, and the run of
+  // characters of the same kind that follows it
+  struct CharRun {
+    CharInfo        info;
+    unsigned short  mblen;    // 0 unless a character starts here
+    unsigned short  run_end;  // offset at which the run stops
+    unsigned short  run_len;  // characters in the run after this one
+  };
+
   std::vector<Dictionary *>              dic_;
-  Dictionary                             unkdic_;
+  size_t                                 open_size_;  // dic_ from open()
+  Dictionary                            *unkdic_;
   scoped_string                          bos_feature_;
   scoped_string                          unk_feature_;
   FreeList<N>                            node_freelist_;
   FreeList<DictionaryInfo>               dictionary_info_freelist_;
   std::vector<std::pair<const Token *, size_t> > unk_tokens_;
   scoped_array<Dictionary::result_type>  daresults_;
+  std::vector<Dictionary::prefetch_type> prefetch_;
+  const char                            *prefetch_pos_;
+  size_t                                 prefetch_slot_;
+  std::vector<CharRun>                   char_runs_;
+  const char                            *char_begin_;
+  const char                            *char_end_;
   DictionaryInfo                        *dictionary_info_;
   CharInfo                               space_;
-  CharProperty                           property_;
+  CharProperty                          *property_;
   size_t                                 max_grouping_size_;
   unsigned int                           id_;
+  bool                                   shared_;
   whatlog                                what_;
 
+  void initPrefetch();
+  void prefetch(const char *begin, const char *end);
+  void buildCharRuns(const char *begin, const char *end);
+  const char *seekRun(const char *begin, const char *end,
+                      const CharInfo &c, size_t mblen, size_t *clen) const;
+
+  inline CharInfo getCharInfo(const char *begin, const char *end,
+                              size_t *mblen) const {
+    if (end == char_end_ && begin >= char_begin_ && begin < char_end_) {
+      const CharRun &r = char_runs_[begin - char_begin_];
+      if (r.mblen) {
+        *mblen = r.mblen;
+        return r.info;
+      }
+    }
+    return property_->getCharInfo(begin, end, mblen);
+  }
+
+  inline const char *seekToOtherType(const char *begin, const char *end,
+                                     CharInfo c, CharInfo *fail,
+                                     size_t *mblen, size_t *clen) const {
+    const char *p = begin;
+    *clen = 0;
+    while (p != end && c.isKindOf(*fail = getCharInfo(p, end, mblen))) {
+      p += *mblen;
+      ++(*clen);
+      c = *fail;
+    }
+    return p;
+  }
+
  public:
 
   inline N *getNewNode() {
@@ -50,9 +98,21 @@ class TokenizerImpl {
   N *lookup(const char *begin, const char *end);
 
   bool open(const Param &);
+  // shares the read-only dictionaries of |model|, which must outlive
+  // this tokenizer. lattice nodes and lookup buffers stay private.
+  bool open(const TokenizerImpl<N, P> &model);
   void close();
   void clear();
 
+  // looks words up in |userdic| after the dictionaries given at open
+  // time, in place of the one attached before (none when 0). |userdic| is
+  // not owned, and dictionary_info() keeps listing the open-time ones.
+  void attach(Dictionary *userdic);
+
+  const Dictionary *system_dictionary() const {
+    return dic_.empty() ? 0 : dic_[0];
+  }
+
   const DictionaryInfo *dictionary_info() const;
 
   const char *what() { return what_.str(); }
@@ -230,6 +230,33 @@ bool escape_csv_element(std::string *w) {
   return true;
 }
 
+namespace {
+MECAB_THREAD_LOCAL die_trap *current_die_trap = 0;
+}
+
+die_trap::die_trap(): prev_(current_die_trap) {
+  current_die_trap = this;
+}
+
+die_trap::~die_trap() {
+  current_die_trap = prev_;
+}
+
+die_trap *die_trap::current() {
+  return current_die_trap;
+}
+
+std::ostream &die::stream() {
+  if (current_die_trap) return current_die_trap->stream_;
+  return std::cerr;
+}
+
+die::~die() MECAB_DIE_NOEXCEPT {
+  if (current_die_trap) throw die_error();
+  std::cerr << std::endl;
+  exit(-1);
+}
+
 int progress_bar(const char* message, size_t current, size_t total) {
   static char bar[] = "###########################################";
   static int scale = sizeof(bar) - 1;
@@ -91,6 +91,18 @@ bool partial_match(const char *f1, const char *f2) {
   }
   return true;
 }
+
+// drops the storage a long sentence left behind, so that the buffers
+// reused across analyses stay below MAX_LATTICE_BUFFER_SIZE.
+template <class T>
+void shrink_buffer(std::vector<T> *v, size_t len) {
+  if (v->capacity() > MAX_LATTICE_BUFFER_SIZE &&
+      len <= MAX_LATTICE_BUFFER_SIZE) {
+    std::vector<T> tmp;
+    tmp.reserve(_max(len, static_cast<size_t>(MIN_INPUT_BUFFER_SIZE)));
+    v->swap(tmp);
+  }
+}
 }
 
 Viterbi::Viterbi() : level_(0), theta_(0.0), cost_factor_(0),
@@ -98,7 +110,8 @@ Viterbi::Viterbi() : level_(0), theta_(0.0), cost_factor_(0),
 
 Viterbi::~Viterbi() { close(); }
 
-bool Viterbi::open(const Param &param, Tokenizer *t, Connector *c) {
+bool Viterbi::open(const Param &param, Tokenizer *t,
+                   const Connector *c) {
   tokenizer_ = t;
   connector_ = c;
 
@@ -146,6 +159,11 @@ void Viterbi::set_all_morphs(bool all_morphs) {
 }
 
 Node *Viterbi::analyze(const char *str, size_t len) {
+  shrink_buffer(&end_node_list_, len + 4);
+  shrink_buffer(&begin_node_list_, len + 4);
+  shrink_buffer(&sentence_, len + 1);
+  shrink_buffer(&constraint_buf_, len + 1);
+
   if (!partial_ && copy_sentence_) {
     sentence_.resize(len + 1);
     std::strncpy(&sentence_[0], str, len);
@@ -174,7 +192,7 @@ Node *Viterbi::analyze(const char *str, size_t len) {
 void Viterbi::clear() {
   tokenizer_->clear();
   Z_ = 0.0;
-  if (path_freelist_.get()) path_freelist_->free();
+  if (path_freelist_.get()) path_freelist_->free(PATH_FREELIST_MAX);
 }
 
 bool Viterbi::forwardbackward(const char *sentence, size_t len) {
@@ -19,7 +19,7 @@ class Connector;
 class Viterbi {
  private:
   Tokenizer*           tokenizer_;
-  Connector*           connector_;
+  const Connector*     connector_;
   Node*                eosNode_;
   Node*                bosNode_;
   const char*          begin_;
@@ -62,7 +62,7 @@ class Viterbi {
 
  public:
   void clear();
-  bool open(const Param &param, Tokenizer *t, Connector *c);
+  bool open(const Param &param, Tokenizer *t, const Connector *c);
   void close();
 
   double Z() const { return Z_; }
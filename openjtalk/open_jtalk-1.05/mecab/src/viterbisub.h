@@ -19,14 +19,12 @@ bool Viterbi::connectWithAllPath(size_t pos, Node *rNode) {
       register long bestCost = 2147483647;
 
       Node* bestNode = 0;
+      const short *row  = connector_->row(rNode->lcAttr);
+      const int   wcost = rNode->wcost;
 
       for (Node *lNode = end_node_list_[pos]; lNode; lNode = lNode->enext) {
-#ifdef _VITERBI_WITH_ALL_PATH
-        register int  lcost = connector_->cost(lNode, rNode);  // local cost
+        register int  lcost = row[lNode->rcAttr] + wcost;  // local cost
         register long cost  = lNode->cost + lcost;
-#else
-        register long cost  = lNode->cost + connector_->cost(lNode, rNode);
-#endif
 
         if (cost < bestCost) {
           bestNode  = lNode;
@@ -55,6 +55,7 @@ MECAB2NJD_C_START;
 #include <stdlib.h>
 
 #include "njd.h"
+#include "mecab.h"
 #include "mecab2njd.h"
 
 void mecab2njd(NJD * njd, char **feature, int size)
@@ -63,13 +64,26 @@ void mecab2njd(NJD * njd, char **feature, int size)
    NJDNode *node;
 
    for (i = 0; i < size; i++) {
-      node = (NJDNode *) calloc(1, sizeof(NJDNode));
-      NJDNode_initialize(node);
+      node = NJD_new_node(njd);
       NJDNode_load(node, feature[i]);
       NJD_push_node(njd, node);
    }
 }
 
+void mecab2njd_from_node(NJD * njd, const mecab_node_t * head)
+{
+   const mecab_node_t *m;
+   NJDNode *node;
+
+   for (m = head; m != NULL; m = m->next) {
+      if (m->stat == MECAB_BOS_NODE || m->stat == MECAB_EOS_NODE)
+         continue;
+      node = NJD_new_node(njd);
+      NJDNode_load_from_feature(node, m->surface, m->length, m->feature);
+      NJD_push_node(njd, node);
+   }
+}
+
 MECAB2NJD_C_END;
 
 #endif                          /* !MECAB2NJD_C */
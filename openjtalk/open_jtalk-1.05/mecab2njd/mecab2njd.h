@@ -53,6 +53,10 @@ MECAB2NJD_H_START;
 
 void mecab2njd(NJD * njd, char **feature, int size);
 
+/* convert MeCab nodes directly without building "surface,feature" strings */
+struct mecab_node_t;
+void mecab2njd_from_node(NJD * njd, const struct mecab_node_t *head);
+
 MECAB2NJD_H_END;
 
 #endif                          /* !MECAB2NJD_H */
@@ -4,7 +4,7 @@ CC = cl
 CFLAGS = /O2 /Ob2 /Oi /Ot /Oy /GT /GL /TC /D CHARSET_SHIFT_JIS
 LFLAGS = /LTCG
 
-CORES = njd.obj njd_node.obj
+CORES = njd.obj njd_arena.obj njd_node.obj njd_trie.obj
 
 all: njd.lib
 
@@ -59,6 +59,9 @@ NJD_C_START;
 
 #define MAXBUFLEN 1024
 
+/* nodes and strings only need the alignment of pointers and ints */
+#define NJD_ARENA_ALIGN 8
+
 static int get_token_from_string(char *str, int *index, char *buff, char d)
 {
    char c;
@@ -125,6 +128,18 @@ void NJD_initialize(NJD * njd)
 {
    njd->head = NULL;
    njd->tail = NULL;
+   NJDArena_initialize(&njd->arena, NJD_ARENA_ALIGN);
+}
+
+/* allocate a node whose storage is released by NJD_refresh() */
+NJDNode *NJD_new_node(NJD * njd)
+{
+   NJDNode *node;
+
+   node = (NJDNode *) NJDArena_alloc(&njd->arena, sizeof(NJDNode));
+   NJDNode_initialize(node);
+   node->arena = &njd->arena;
+   return node;
 }
 
 void NJD_load(NJD * njd, char *str)
@@ -175,8 +190,7 @@ void NJD_load(NJD * njd, char *str)
       get_token_from_string(str, &i, chain_rule, ',');
       if (get_token_from_string(str, &i, chain_flag, ',') <= 0)
          break;
-      node = (NJDNode *) calloc(1, sizeof(NJDNode));
-      NJDNode_initialize(node);
+      node = NJD_new_node(njd);
       NJDNode_set_string(node, string);
       NJDNode_set_pos(node, pos);
       NJDNode_set_pos_group1(node, pos_group1);
@@ -242,8 +256,7 @@ void NJD_load_from_fp(NJD * njd, FILE * fp)
       get_token_from_fp(fp, chain_rule, ',');
       if (get_token_from_fp(fp, chain_flag, ',') <= 0)
          break;
-      node = (NJDNode *) calloc(1, sizeof(NJDNode));
-      NJDNode_initialize(node);
+      node = NJD_new_node(njd);
       NJDNode_set_string(node, string);
       NJDNode_set_pos(node, pos);
       NJDNode_set_pos_group1(node, pos_group1);
@@ -348,8 +361,10 @@ NJDNode *NJD_remove_node(NJD * njd, NJDNode * node)
       node->next->prev = node->prev;
       next = node->next;
    }
-   NJDNode_clear(node);
-   free(node);
+   if (node->arena == NULL) {
+      NJDNode_clear(node);
+      free(node);
+   }
    return next;
 }
 
@@ -386,25 +401,34 @@ void NJD_sprint(NJD * njd, char *buff, const char *split_code)
       NJDNode_sprint(node, buff, split_code);
 }
 
-void NJD_refresh(NJD * njd)
-{
-   NJD_clear(njd);
-   NJD_initialize(njd);
-}
-
-void NJD_clear(NJD * njd)
+/* free nodes which are not allocated from the arena */
+static void NJD_clear_node(NJD * njd)
 {
    NJDNode *node;
 
    while (njd->head != NULL) {
       node = njd->head->next;
-      NJDNode_clear(njd->head);
-      free(njd->head);
+      if (njd->head->arena == NULL) {
+         NJDNode_clear(njd->head);
+         free(njd->head);
+      }
       njd->head = node;
    }
    njd->tail = NULL;
 }
 
+void NJD_refresh(NJD * njd)
+{
+   NJD_clear_node(njd);
+   NJDArena_reset(&njd->arena);
+}
+
+void NJD_clear(NJD * njd)
+{
+   NJD_clear_node(njd);
+   NJDArena_clear(&njd->arena);
+}
+
 NJD_C_END;
 
 #endif                          /* !NJD_C */
@@ -49,8 +49,93 @@
 #define NJD_H_END
 #endif                          /* __CPLUSPLUS */
 
+#if !defined(_WIN32) || defined(__CYGWIN__)
+#include <pthread.h>
+#endif                          /* !_WIN32 || __CYGWIN__ */
+
 NJD_H_START;
 
+/* NJDArena */
+
+typedef struct _NJDArenaBlock {
+   size_t size;
+   size_t used;
+   struct _NJDArenaBlock *next;
+} NJDArenaBlock;
+
+typedef struct _NJDArena {
+   NJDArenaBlock *head;
+   NJDArenaBlock *current;
+   char *last;                  /* latest allocation, can be grown in place */
+   size_t align;                /* alignment of allocations, a power of two up to that of malloc */
+} NJDArena;
+
+void NJDArena_initialize(NJDArena * arena, size_t align);
+void *NJDArena_alloc(NJDArena * arena, size_t size);
+void *NJDArena_calloc(NJDArena * arena, size_t num, size_t size);
+char *NJDArena_strndup(NJDArena * arena, const char *str, size_t len);
+char *NJDArena_strcat(NJDArena * arena, char *dst, const char *src);
+void NJDArena_reset(NJDArena * arena);
+void NJDArena_clear(NJDArena * arena);
+
+/* NJDTrie */
+
+typedef struct _NJDTrieNode {
+   int rule;                    /* list index of the first rule ending here, or -1 */
+   int child;                   /* first child, or 0 */
+   int sibling;                 /* next sibling sorted by label, or 0 */
+   unsigned char label;
+} NJDTrieNode;
+
+typedef struct _NJDTrie {
+   int root[256];               /* node of each first byte, or 0 */
+   NJDTrieNode *node;           /* NULL until initialized */
+   int size;
+} NJDTrie;
+
+void NJDTrie_initialize(NJDTrie * trie, const char **list, int num);
+int NJDTrie_find(NJDTrie * trie, const char *str, int *len);
+int NJDTrie_find_exact(NJDTrie * trie, const char *str);
+void NJDTrie_clear(NJDTrie * trie);
+
+/* NJDOnce: guard of tables which are built on first use and shared by threads */
+
+#if defined(_WIN32) && !defined(__CYGWIN__)
+typedef volatile long NJDOnce;
+#define NJD_ONCE_INIT 0
+#else
+typedef pthread_once_t NJDOnce;
+#define NJD_ONCE_INIT PTHREAD_ONCE_INIT
+#endif                          /* _WIN32 && !__CYGWIN__ */
+
+void NJDOnce_call(NJDOnce * once, void (*func) (void));
+
+/* NJDChainRule */
+
+/* accent change types of chain rules */
+#define NJD_CHAIN_RULE_NONE 0   /* no change */
+#define NJD_CHAIN_RULE_F1   1   /* for ancillary word */
+#define NJD_CHAIN_RULE_F2   2
+#define NJD_CHAIN_RULE_F3   3
+#define NJD_CHAIN_RULE_F4   4
+#define NJD_CHAIN_RULE_F5   5
+#define NJD_CHAIN_RULE_C1   6   /* for noun */
+#define NJD_CHAIN_RULE_C2   7
+#define NJD_CHAIN_RULE_C3   8
+#define NJD_CHAIN_RULE_C4   9
+#define NJD_CHAIN_RULE_C5   10
+#define NJD_CHAIN_RULE_P1   11  /* for postfix */
+#define NJD_CHAIN_RULE_P2   12
+#define NJD_CHAIN_RULE_P6   13
+#define NJD_CHAIN_RULE_P14  14
+
+/* one alternative of chain rule such as "POS%F2@1" */
+typedef struct _NJDChainRule {
+   char *pos;                   /* POS of the previous word, NULL for any */
+   int type;                    /* NJD_CHAIN_RULE_* */
+   int add_type;
+} NJDChainRule;
+
 /* NJDNode */
 
 typedef struct _NJDNode {
@@ -67,9 +152,12 @@ typedef struct _NJDNode {
    int acc;                     /* accent */
    int mora_size;
    char *chain_rule;
+   NJDChainRule *chain_rule_list;       /* chain_rule compiled when it is set */
+   int chain_rule_size;
    int chain_flag;
    struct _NJDNode *prev;
    struct _NJDNode *next;
+   NJDArena *arena;             /* storage of node and strings, NULL for heap */
 } NJDNode;
 
 void NJDNode_initialize(NJDNode * node);
@@ -104,8 +192,11 @@ char *NJDNode_get_pron(NJDNode * node);
 int NJDNode_get_acc(NJDNode * node);
 int NJDNode_get_mora_size(NJDNode * node);
 char *NJDNode_get_chain_rule(NJDNode * node);
+int NJDNode_get_chain_rule_type(NJDNode * node, const char *prev_pos, int *add_type);
 int NJDNode_get_chain_flag(NJDNode * node);
 void NJDNode_load(NJDNode * node, char *str);
+void NJDNode_load_from_feature(NJDNode * node, const char *surface, size_t length,
+                               const char *feature);
 NJDNode *NJDNode_insert(NJDNode * prev, NJDNode * next, NJDNode * node);
 void NJDNode_copy(NJDNode * node1, NJDNode * node2);
 void NJDNode_print(NJDNode * node);
@@ -118,9 +209,11 @@ void NJDNode_clear(NJDNode * node);
 typedef struct _NJD {
    NJDNode *head;
    NJDNode *tail;
+   NJDArena arena;              /* per-utterance nodes and strings */
 } NJD;
 
 void NJD_initialize(NJD * njd);
+NJDNode *NJD_new_node(NJD * njd);
 void NJD_load(NJD * njd, char *str);
 void NJD_load_from_fp(NJD * njd, FILE * fp);
 int NJD_get_size(NJD * njd);
@@ -0,0 +1,195 @@
+/* ----------------------------------------------------------------- */
+/*           The Japanese TTS System "Open JTalk"                    */
+/*           developed by HTS Working Group                          */
+/*           http://open-jtalk.sourceforge.net/                      */
+/* ----------------------------------------------------------------- */
+/*                                                                   */
+/*  Copyright (c) 2008-2011  Nagoya Institute of Technology          */
+/*                           Department of Computer Science          */
+/*                                                                   */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/* - Redistributions of source code must retain the above copyright  */
+/*   notice, this list of conditions and the following disclaimer.   */
+/* - Redistributions in binary form must reproduce the above         */
+/*   copyright notice, this list of conditions and the following     */
+/*   disclaimer in the documentation and/or other materials provided */
+/*   with the distribution.                                          */
+/* - Neither the name of the HTS working group nor the names of its  */
+/*   contributors may be used to endorse or promote products derived */
+/*   from this software without specific prior written permission.   */
+/*                                                                   */
+/* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND            */
+/* CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,       */
+/* INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF          */
+/* MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE          */
+/* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS */
+/* BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,          */
+/* EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED   */
+/* TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,     */
+/* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON */
+/* ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,   */
+/* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY    */
+/* OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE           */
+/* POSSIBILITY OF SUCH DAMAGE.                                       */
+/* ----------------------------------------------------------------- */
+#ifndef NJD_ARENA_C
+#define NJD_ARENA_C
+
+#ifdef __cplusplus
+#define NJD_ARENA_C_START extern "C" {
+#define NJD_ARENA_C_END   }
+#else
+#define NJD_ARENA_C_START
+#define NJD_ARENA_C_END
+#endif                          /* __CPLUSPLUS */
+
+NJD_ARENA_C_START;
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "njd.h"
+
+#define NJD_ARENA_BLOCK_SIZE 65536
+
+#define NJD_ARENA_ROUND(arena, size) \
+   (((size) + (arena)->align - 1) & ~((arena)->align - 1))
+
+/* header of each block, rounded up so that the payload stays aligned */
+#define NJD_ARENA_HEADER_SIZE(arena) NJD_ARENA_ROUND(arena, sizeof(NJDArenaBlock))
+
+#define NJD_ARENA_PAYLOAD(arena, b) ((char *) (b) + NJD_ARENA_HEADER_SIZE(arena))
+
+static NJDArenaBlock *NJDArenaBlock_new(NJDArena * arena, size_t size)
+{
+   NJDArenaBlock *b;
+
+   b = (NJDArenaBlock *) malloc(NJD_ARENA_HEADER_SIZE(arena) + size);
+   if (b == NULL) {
+      fprintf(stderr, "ERROR: NJDArenaBlock_new() in njd_arena.c: Cannot allocate memory.\n");
+      exit(1);
+   }
+   b->size = size;
+   b->used = 0;
+   b->next = NULL;
+   return b;
+}
+
+void NJDArena_initialize(NJDArena * arena, size_t align)
+{
+   arena->head = NULL;
+   arena->current = NULL;
+   arena->last = NULL;
+   arena->align = align;
+}
+
+void *NJDArena_alloc(NJDArena * arena, size_t size)
+{
+   NJDArenaBlock *b;
+   NJDArenaBlock *prev;
+   char *p;
+
+   size = NJD_ARENA_ROUND(arena, size);
+   if (size == 0)
+      size = arena->align;
+
+   /* find a block with enough space, reusing blocks kept by reset */
+   prev = arena->current;
+   b = arena->current;
+   while (b != NULL && b->size - b->used < size) {
+      prev = b;
+      b = b->next;
+      if (b != NULL)
+         b->used = 0;
+   }
+   if (b == NULL) {
+      b = NJDArenaBlock_new(arena, size > NJD_ARENA_BLOCK_SIZE ? size : NJD_ARENA_BLOCK_SIZE);
+      if (prev == NULL) {
+         b->next = arena->head;
+         arena->head = b;
+      } else {
+         b->next = prev->next;
+         prev->next = b;
+      }
+   }
+   arena->current = b;
+
+   p = NJD_ARENA_PAYLOAD(arena, b) + b->used;
+   b->used += size;
+   arena->last = p;
+   return p;
+}
+
+void *NJDArena_calloc(NJDArena * arena, size_t num, size_t size)
+{
+   void *p = NJDArena_alloc(arena, num * size);
+
+   memset(p, 0, num * size);
+   return p;
+}
+
+char *NJDArena_strndup(NJDArena * arena, const char *str, size_t len)
+{
+   char *p = (char *) NJDArena_alloc(arena, len + 1);
+
+   memcpy(p, str, len);
+   p[len] = '\0';
+   return p;
+}
+
+/* Append 'src' to 'dst' and return the result.
+   If 'dst' is the latest allocation, it is grown in place. */
+char *NJDArena_strcat(NJDArena * arena, char *dst, const char *src)
+{
+   size_t dlen, slen, offset;
+   NJDArenaBlock *b = arena->current;
+   char *p;
+
+   if (dst == NULL)
+      return NJDArena_strndup(arena, src, strlen(src));
+   dlen = strlen(dst);
+   slen = strlen(src);
+   if (dst == arena->last && b != NULL) {
+      offset = dst - NJD_ARENA_PAYLOAD(arena, b);
+      if (offset + dlen + slen + 1 <= b->size) {
+         memcpy(dst + dlen, src, slen + 1);
+         b->used = offset + NJD_ARENA_ROUND(arena, dlen + slen + 1);
+         return dst;
+      }
+   }
+   p = (char *) NJDArena_alloc(arena, dlen + slen + 1);
+   memcpy(p, dst, dlen);
+   memcpy(p + dlen, src, slen + 1);
+   return p;
+}
+
+void NJDArena_reset(NJDArena * arena)
+{
+   arena->current = arena->head;
+   if (arena->current != NULL)
+      arena->current->used = 0;
+   arena->last = NULL;
+}
+
+void NJDArena_clear(NJDArena * arena)
+{
+   NJDArenaBlock *b;
+
+   while (arena->head != NULL) {
+      b = arena->head->next;
+      free(arena->head);
+      arena->head = b;
+   }
+   arena->current = NULL;
+   arena->last = NULL;
+}
+
+NJD_ARENA_C_END;
+
+#endif                          /* !NJD_ARENA_C */
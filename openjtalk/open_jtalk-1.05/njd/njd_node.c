@@ -69,43 +69,31 @@ NJD_NODE_C_START;
 
 #define MAXBUFLEN 1024
 
-/* If head of 'str' is equal to 'pattern', return length of 'pattern'.
-   If head of 'str' is not equal to 'pattern', return '-1'. */
-static int strtopcmp(char *str, const char *pattern)
-{
-   int i;
+static NJDTrie njd_mora_trie;
+static NJDOnce njd_mora_trie_once = NJD_ONCE_INIT;
 
-   for (i = 0;; i++) {
-      if (pattern[i] == '\0')
-         return i;
-      if (str[i] == '\0')
-         return -1;
-      if (str[i] != pattern[i])
-         return -1;
-   }
+static void initialize_mora_trie(void)
+{
+   NJDTrie_initialize(&njd_mora_trie, njd_mora_list, 1);
 }
 
 /* Copy 'n' mora from 'str' to 'buff' and return length of 'buff'.
    If 'str' is not appropriate mora, return '0'. */
 static int morancpy(char *buff, char *str, int n)
 {
-   int i, j;
+   int i;
    int s = 0, e = 0;
 
+   NJDOnce_call(&njd_mora_trie_once, initialize_mora_trie);
    for (i = 0; i < n; i++) {
-      for (j = 0; njd_mora_list[j] != NULL; j++) {
-         e = strtopcmp(&str[s], njd_mora_list[j]);
-         if (e != -1)
-            break;
-      }
-      if (e != -1)
+      if (NJDTrie_find(&njd_mora_trie, &str[s], &e) >= 0)
          s += e;
       else {
          buff[0] = '\0';
          return 0;
       }
    }
-   strncpy(buff, str, s);
+   memcpy(buff, str, s);
    buff[s] = '\0';
    return s;
 }
@@ -127,6 +115,158 @@ static void get_token_from_string(char *str, int *index, char *buff, const char
    buff[i] = '\0';
 }
 
+/* Replace '*field' with a copy of the first 'len' bytes of 'str'.
+   If 'len' is '0', '*field' is set to NULL. */
+static void set_field(NJDNode * node, char **field, const char *str, size_t len)
+{
+   if (node->arena != NULL) {
+      *field = len == 0 ? NULL : NJDArena_strndup(node->arena, str, len);
+      return;
+   }
+   if (*field != NULL)
+      free(*field);
+   if (len == 0) {
+      *field = NULL;
+   } else {
+      *field = (char *) malloc(len + 1);
+      memcpy(*field, str, len);
+      (*field)[len] = '\0';
+   }
+}
+
+/* Append 'str' to '*field'. */
+static void add_field(NJDNode * node, char **field, const char *str)
+{
+   char *c;
+
+   if (str == NULL)
+      return;
+   if (node->arena != NULL) {
+      *field = NJDArena_strcat(node->arena, *field, str);
+   } else if (*field == NULL) {
+      *field = strdup(str);
+   } else {
+      c = (char *) calloc(strlen(*field) + strlen(str) + 1, sizeof(char));
+      strcpy(c, *field);
+      strcat(c, str);
+      free(*field);
+      *field = c;
+   }
+}
+
+static char get_chain_rule_token(const char *str, int *index, char *buff)
+{
+   char c;
+   int i = 0;
+
+   c = str[(*index)];
+   if (c != '\0') {
+      while (c != '%' && c != '@' && c != '/' && c != '\0') {
+         if (i < MAXBUFLEN - 1)
+            buff[i++] = c;
+         c = str[++(*index)];
+      }
+      if (c == '%' || c == '@' || c == '/')
+         (*index)++;
+   }
+   buff[i] = '\0';
+   return c;
+}
+
+static int get_chain_rule_type(const char *str)
+{
+   int i;
+
+   for (i = 0; njd_chain_rule_list[i] != NULL; i++)
+      if (strcmp(str, njd_chain_rule_list[i]) == 0)
+         return i + 1;
+   return NJD_CHAIN_RULE_NONE;
+}
+
+static void clear_chain_rule_list(NJDNode * node)
+{
+   if (node->arena == NULL && node->chain_rule_list != NULL)
+      free(node->chain_rule_list);
+   node->chain_rule_list = NULL;
+   node->chain_rule_size = 0;
+}
+
+/* Compile chain rule such as "POS1%F2@1/POS2%C3/F1" into alternatives.
+   They are tried in order, and an alternative without POS ends the rule. */
+static void set_chain_rule_list(NJDNode * node)
+{
+   int i, n, next;
+   char c = ' ';
+   char buff[MAXBUFLEN];
+   char rule[MAXBUFLEN];
+   const char *str = node->chain_rule;
+   size_t size;
+   NJDChainRule *list;
+   char *p;
+
+   clear_chain_rule_list(node);
+   if (str == NULL)
+      return;
+
+   /* each alternative ends with '/', and POS strings are shorter than the rule */
+   for (i = 0, n = 1; str[i] != '\0'; i++)
+      if (str[i] == '/')
+         n++;
+   size = n * sizeof(NJDChainRule) + strlen(str) + n;
+   if (node->arena != NULL)
+      list = (NJDChainRule *) NJDArena_alloc(node->arena, size);
+   else
+      list = (NJDChainRule *) malloc(size);
+   p = (char *) &list[n];
+
+   for (i = 0, n = 0; c != '\0'; n++) {
+      c = get_chain_rule_token(str, &i, buff);
+      list[n].add_type = 0;
+      if (c == '%') {
+         /* conditional */
+         next = i;
+         list[n].pos = strcpy(p, buff);
+         p += strlen(buff) + 1;
+         if (get_chain_rule_token(str, &next, rule) == '@') {
+            list[n].type = get_chain_rule_type(rule);
+            get_chain_rule_token(str, &next, buff);
+            list[n].add_type = atoi(buff);
+         } else {
+            list[n].type = get_chain_rule_type(rule);
+         }
+         /* skip to next alternative */
+         while (c == '%' || c == '@')
+            c = get_chain_rule_token(str, &i, buff);
+      } else {
+         /* unconditional */
+         list[n].pos = NULL;
+         list[n].type = get_chain_rule_type(buff);
+         if (c == '@') {
+            get_chain_rule_token(str, &i, buff);
+            list[n].add_type = atoi(buff);
+         }
+         n++;
+         break;
+      }
+   }
+   node->chain_rule_list = list;
+   node->chain_rule_size = n;
+}
+
+/* Allocate a node from the same storage as 'node'. */
+static NJDNode *new_node(NJDNode * node)
+{
+   NJDNode *n;
+
+   if (node->arena != NULL)
+      n = (NJDNode *) NJDArena_alloc(node->arena, sizeof(NJDNode));
+   else
+      n = (NJDNode *) calloc(1, sizeof(NJDNode));
+   NJDNode_initialize(n);
+   n->arena = node->arena;
+   return n;
+}
+
 void NJDNode_initialize(NJDNode * node)
 {
    node->string = NULL;
@@ -142,109 +282,62 @@ void NJDNode_initialize(NJDNode * node)
    node->acc = 0;
    node->mora_size = 0;
    node->chain_rule = NULL;
+   node->chain_rule_list = NULL;
+   node->chain_rule_size = 0;
    node->chain_flag = -1;
    node->prev = NULL;
    node->next = NULL;
+   node->arena = NULL;
 }
 
 void NJDNode_set_string(NJDNode * node, char *str)
 {
-   if (node->string != NULL)
-      free(node->string);
-   if (str == NULL || strlen(str) == 0)
-      node->string = NULL;
-   else
-      node->string = strdup(str);
+   set_field(node, &node->string, str, str == NULL ? 0 : strlen(str));
 }
 
 void NJDNode_set_pos(NJDNode * node, char *str)
 {
-   if (node->pos != NULL)
-      free(node->pos);
-   if (str == NULL || strlen(str) == 0)
-      node->pos = NULL;
-   else
-      node->pos = strdup(str);
+   set_field(node, &node->pos, str, str == NULL ? 0 : strlen(str));
 }
 
 void NJDNode_set_pos_group1(NJDNode * node, char *str)
 {
-   if (node->pos_group1 != NULL)
-      free(node->pos_group1);
-   if (str == NULL || strlen(str) == 0)
-      node->pos_group1 = NULL;
-   else
-      node->pos_group1 = strdup(str);
+   set_field(node, &node->pos_group1, str, str == NULL ? 0 : strlen(str));
 }
 
 void NJDNode_set_pos_group2(NJDNode * node, char *str)
 {
-   if (node->pos_group2 != NULL)
-      free(node->pos_group2);
-   if (str == NULL || strlen(str) == 0)
-      node->pos_group2 = NULL;
-   else
-      node->pos_group2 = strdup(str);
+   set_field(node, &node->pos_group2, str, str == NULL ? 0 : strlen(str));
 }
 
 void NJDNode_set_pos_group3(NJDNode * node, char *str)
 {
-   if (node->pos_group3 != NULL)
-      free(node->pos_group3);
-   if (str == NULL || strlen(str) == 0)
-      node->pos_group3 = NULL;
-   else
-      node->pos_group3 = strdup(str);
+   set_field(node, &node->pos_group3, str, str == NULL ? 0 : strlen(str));
 }
 
 void NJDNode_set_ctype(NJDNode * node, char *str)
 {
-   if (node->ctype != NULL)
-      free(node->ctype);
-   if (str == NULL || strlen(str) == 0)
-      node->ctype = NULL;
-   else
-      node->ctype = strdup(str);
+   set_field(node, &node->ctype, str, str == NULL ? 0 : strlen(str));
 }
 
 void NJDNode_set_cform(NJDNode * node, char *str)
 {
-   if (node->cform != NULL)
-      free(node->cform);
-   if (str == NULL || strlen(str) == 0)
-      node->cform = NULL;
-   else
-      node->cform = strdup(str);
+   set_field(node, &node->cform, str, str == NULL ? 0 : strlen(str));
 }
 
 void NJDNode_set_orig(NJDNode * node, char *str)
 {
-   if (node->orig != NULL)
-      free(node->orig);
-   if (str == NULL || strlen(str) == 0)
-      node->orig = NULL;
-   else
-      node->orig = strdup(str);
+   set_field(node, &node->orig, str, str == NULL ? 0 : strlen(str));
 }
 
 void NJDNode_set_read(NJDNode * node, char *str)
 {
-   if (node->read != NULL)
-      free(node->read);
-   if (str == NULL || strlen(str) == 0)
-      node->read = NULL;
-   else
-      node->read = strdup(str);
+   set_field(node, &node->read, str, str == NULL ? 0 : strlen(str));
 }
 
 void NJDNode_set_pron(NJDNode * node, char *str)
 {
-   if (node->pron != NULL)
-      free(node->pron);
-   if (str == NULL || strlen(str) == 0)
-      node->pron = NULL;
-   else
-      node->pron = strdup(str);
+   set_field(node, &node->pron, str, str == NULL ? 0 : strlen(str));
 }
 
 void NJDNode_set_acc(NJDNode * node, int acc)
@@ -268,12 +361,8 @@ void NJDNode_set_mora_size(NJDNode * node, int size)
 
 void NJDNode_set_chain_rule(NJDNode * node, char *str)
 {
-   if (node->chain_rule != NULL)
-      free(node->chain_rule);
-   if (str == NULL || strlen(str) == 0)
-      node->chain_rule = NULL;
-   else
-      node->chain_rule = strdup(str);
+   set_field(node, &node->chain_rule, str, str == NULL ? 0 : strlen(str));
+   set_chain_rule_list(node);
 }
 
 void NJDNode_set_chain_flag(NJDNode * node, int flag)
@@ -283,36 +372,12 @@ void NJDNode_set_chain_flag(NJDNode * node, int flag)
 
 void NJDNode_add_read(NJDNode * node, char *str)
 {
-   char *c;
-
-   if (str != NULL) {
-      if (node->read == NULL) {
-         node->read = strdup(str);
-      } else {
-         c = (char *) calloc(strlen(node->read) + strlen(str) + 1, sizeof(char));
-         strcpy(c, node->read);
-         strcat(c, str);
-         free(node->read);
-         node->read = c;
-      }
-   }
+   add_field(node, &node->read, str);
 }
 
 void NJDNode_add_pron(NJDNode * node, char *str)
 {
-   char *c;
-
-   if (str != NULL) {
-      if (node->pron == NULL) {
-         node->pron = strdup(str);
-      } else {
-         c = (char *) calloc(strlen(node->pron) + strlen(str) + 1, sizeof(char));
-         strcpy(c, node->pron);
-         strcat(c, str);
-         free(node->pron);
-         node->pron = c;
-      }
-   }
+   add_field(node, &node->pron, str);
 }
 
 void NJDNode_add_acc(NJDNode * node, int acc)
@@ -399,57 +464,91 @@ char *NJDNode_get_chain_rule(NJDNode * node)
    return node->chain_rule;
 }
 
+/* Return accent change type of the chain rule for 'prev_pos', and set its additional type. */
+int NJDNode_get_chain_rule_type(NJDNode * node, const char *prev_pos, int *add_type)
+{
+   int i;
+   NJDChainRule *rule;
+
+   for (i = 0; i < node->chain_rule_size; i++) {
+      rule = &node->chain_rule_list[i];
+      if (rule->pos == NULL || (prev_pos != NULL && strstr(prev_pos, rule->pos) != NULL)) {
+         *add_type = rule->add_type;
+         return rule->type;
+      }
+   }
+   *add_type = 0;
+   return NJD_CHAIN_RULE_NONE;
+}
+
 int NJDNode_get_chain_flag(NJDNode * node)
 {
    return node->chain_flag;
 }
 
+/* Copy at most 'MAXBUFLEN - 1' bytes of 'str' to 'buff'. */
+static void copy_field(char *buff, const char *str, size_t len)
+{
+   if (len >= MAXBUFLEN)
+      len = MAXBUFLEN - 1;
+   memcpy(buff, str, len);
+   buff[len] = '\0';
+}
+
 void NJDNode_load(NJDNode * node, char *str)
+{
+   size_t i;
+
+   for (i = 0; str[i] != ',' && str[i] != '\0'; i++);
+   NJDNode_load_from_feature(node, str, i, str[i] == ',' ? &str[i + 1] : &str[i]);
+}
+
+#define NJDNODE_FEATURE_SIZE 11
+
+void NJDNode_load_from_feature(NJDNode * node, const char *surface, size_t length,
+                               const char *feature)
 {
    int i, j;
    int index = 0;
-   char pron[1024];
-   char buff[1024];
-   char acc[1024];
+   char pron[MAXBUFLEN];
+   char buff[MAXBUFLEN];
+   char acc[MAXBUFLEN];
    int count;
    int *alist;
    int *mlist;
    NJDNode *prev = NULL;
+   const char *field[NJDNODE_FEATURE_SIZE];
+   size_t field_len[NJDNODE_FEATURE_SIZE];
+   const char *p;
+
+   /* slice feature into fields without copying */
+   for (i = 0, p = feature; i < NJDNODE_FEATURE_SIZE; i++) {
+      field[i] = p;
+      while (*p != ',' && *p != '\0')
+         p++;
+      field_len[i] = p - field[i];
+      if (*p == ',')
+         p++;
+   }
 
    /* load */
-   get_token_from_string(str, &index, buff, ',');
-   NJDNode_set_string(node, buff);
-   get_token_from_string(str, &index, buff, ',');
-   NJDNode_set_pos(node, buff);
-   get_token_from_string(str, &index, buff, ',');
-   NJDNode_set_pos_group1(node, buff);
-   get_token_from_string(str, &index, buff, ',');
-   NJDNode_set_pos_group2(node, buff);
-   get_token_from_string(str, &index, buff, ',');
-   NJDNode_set_pos_group3(node, buff);
-   get_token_from_string(str, &index, buff, ',');
-   NJDNode_set_ctype(node, buff);
-   get_token_from_string(str, &index, buff, ',');
-   NJDNode_set_cform(node, buff);
-   get_token_from_string(str, &index, buff, ',');
-   if (strcmp(buff, "") == 0)
-      NJDNode_set_orig(node, NULL);
-   else
-      NJDNode_set_orig(node, buff);
-   get_token_from_string(str, &index, buff, ',');
-   if (strcmp(buff, "") == 0)
-      NJDNode_set_read(node, NULL);
-   else
-      NJDNode_set_read(node, buff);
-   get_token_from_string(str, &index, buff, ',');
-   strcpy(pron, buff);
-   get_token_from_string(str, &index, buff, ',');
-   strcpy(acc, buff);
-   get_token_from_string(str, &index, buff, ',');
-   if (strcmp(buff, "") == 0)
+   set_field(node, &node->string, surface, length);
+   set_field(node, &node->pos, field[0], field_len[0]);
+   set_field(node, &node->pos_group1, field[1], field_len[1]);
+   set_field(node, &node->pos_group2, field[2], field_len[2]);
+   set_field(node, &node->pos_group3, field[3], field_len[3]);
+   set_field(node, &node->ctype, field[4], field_len[4]);
+   set_field(node, &node->cform, field[5], field_len[5]);
+   set_field(node, &node->orig, field[6], field_len[6]);
+   set_field(node, &node->read, field[7], field_len[7]);
+   copy_field(pron, field[8], field_len[8]);
+   copy_field(acc, field[9], field_len[9]);
+   if (field_len[10] == 0)
       NJDNode_set_chain_rule(node, "-1");
-   else
-      NJDNode_set_chain_rule(node, buff);
+   else {
+      set_field(node, &node->chain_rule, field[10], field_len[10]);
+      set_chain_rule_list(node);
+   }
 
    /* for symbol */
    if (strstr(acc, "*") != NULL) {
@@ -502,8 +601,7 @@ void NJDNode_load(NJDNode * node, char *str)
    } else {
       for (i = 0, index = 0; i < count; i++) {
          if (i > 0) {
-            node = (NJDNode *) calloc(1, sizeof(NJDNode));
-            NJDNode_initialize(node);
+            node = new_node(prev);
             NJDNode_copy(node, prev);
             NJDNode_set_string(node, "");
             NJDNode_set_chain_flag(node, 0);
@@ -599,52 +697,20 @@ void NJDNode_sprint(NJDNode * node, char *buff, const char *split_code)
 
 void NJDNode_clear(NJDNode * node)
 {
-   if (node->string != NULL) {
-      free(node->string);
-      node->string = NULL;
-   }
-   if (node->pos != NULL) {
-      free(node->pos);
-      node->pos = NULL;
-   }
-   if (node->pos_group1 != NULL) {
-      free(node->pos_group1);
-      node->pos_group1 = NULL;
-   }
-   if (node->pos_group2 != NULL) {
-      free(node->pos_group2);
-      node->pos_group2 = NULL;
-   }
-   if (node->pos_group3 != NULL) {
-      free(node->pos_group3);
-      node->pos_group3 = NULL;
-   }
-   if (node->ctype != NULL) {
-      free(node->ctype);
-      node->ctype = NULL;
-   }
-   if (node->cform != NULL) {
-      free(node->cform);
-      node->cform = NULL;
-   }
-   if (node->orig != NULL) {
-      free(node->orig);
-      node->orig = NULL;
-   }
-   if (node->read != NULL) {
-      free(node->read);
-      node->read = NULL;
-   }
-   if (node->pron != NULL) {
-      free(node->pron);
-      node->pron = NULL;
-   }
+   set_field(node, &node->string, NULL, 0);
+   set_field(node, &node->pos, NULL, 0);
+   set_field(node, &node->pos_group1, NULL, 0);
+   set_field(node, &node->pos_group2, NULL, 0);
+   set_field(node, &node->pos_group3, NULL, 0);
+   set_field(node, &node->ctype, NULL, 0);
+   set_field(node, &node->cform, NULL, 0);
+   set_field(node, &node->orig, NULL, 0);
+   set_field(node, &node->read, NULL, 0);
+   set_field(node, &node->pron, NULL, 0);
    node->acc = 0;
    node->mora_size = 0;
-   if (node->chain_rule != NULL) {
-      free(node->chain_rule);
-      node->chain_rule = NULL;
-   }
+   set_field(node, &node->chain_rule, NULL, 0);
+   clear_chain_rule_list(node);
    node->chain_flag = 0;
    node->prev = NULL;
    node->next = NULL;
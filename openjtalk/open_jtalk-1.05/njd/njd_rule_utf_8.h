@@ -214,6 +214,14 @@ static const char *njd_mora_list[] = {
    NULL
 };
 
+/* names of accent change types in the order of NJD_CHAIN_RULE_F1 and after */
+static const char *njd_chain_rule_list[] = {
+   "F1", "F2", "F3", "F4", "F5",
+   "C1", "C2", "C3", "C4", "C5",
+   "P1", "P2", "P6", "P14",
+   NULL
+};
+
 NJD_RULE_H_END;
 
 #endif                          /* !NJD_RULE_H */
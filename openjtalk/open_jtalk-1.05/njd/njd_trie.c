@@ -0,0 +1,181 @@
+/* ----------------------------------------------------------------- */
+/*           The Japanese TTS System "Open JTalk"                    */
+/*           developed by HTS Working Group                          */
+/*           http://open-jtalk.sourceforge.net/                      */
+/* ----------------------------------------------------------------- */
+/*                                                                   */
+/*  Copyright (c) 2008-2011  Nagoya Institute of Technology          */
+/*                           Department of Computer Science          */
+/*                                                                   */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/* - Redistributions of source code must retain the above copyright  */
+/*   notice, this list of conditions and the following disclaimer.   */
+/* - Redistributions in binary form must reproduce the above         */
+/*   copyright notice, this list of conditions and the following     */
+/*   disclaimer in the documentation and/or other materials provided */
+/*   with the distribution.                                          */
+/* - Neither the name of the HTS working group nor the names of its  */
+/*   contributors may be used to endorse or promote products derived */
+/*   from this software without specific prior written permission.   */
+/*                                                                   */
+/* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND            */
+/* CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,       */
+/* INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF          */
+/* MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE          */
+/* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS */
+/* BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,          */
+/* EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED   */
+/* TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,     */
+/* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON */
+/* ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,   */
+/* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY    */
+/* OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE           */
+/* POSSIBILITY OF SUCH DAMAGE.                                       */
+/* ----------------------------------------------------------------- */
+#ifndef NJD_TRIE_C
+#define NJD_TRIE_C
+
+#ifdef __cplusplus
+#define NJD_TRIE_C_START extern "C" {
+#define NJD_TRIE_C_END   }
+#else
+#define NJD_TRIE_C_START
+#define NJD_TRIE_C_END
+#endif                          /* __CPLUSPLUS */
+
+NJD_TRIE_C_START;
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_WIN32) && !defined(__CYGWIN__)
+#include <windows.h>
+#endif                          /* _WIN32 && !__CYGWIN__ */
+
+#include "njd.h"
+
+static int NJDTrie_new_node(NJDTrie * trie, unsigned char c, int sibling)
+{
+   int n = trie->size++;
+
+   trie->node[n].rule = -1;
+   trie->node[n].child = 0;
+   trie->node[n].sibling = sibling;
+   trie->node[n].label = c;
+   return n;
+}
+
+/* Build trie from the first column of 'list' which has 'num' columns and ends with NULL.
+   Rules keep their list index, and the first one wins if patterns are duplicated. */
+void NJDTrie_initialize(NJDTrie * trie, const char **list, int num)
+{
+   int i, n;
+   int *link;
+   size_t size;
+   const unsigned char *p;
+
+   /* the number of nodes is at most the total bytes of patterns */
+   for (i = 0, size = 1; list[i] != NULL; i += num)
+      size += strlen(list[i]);
+   trie->node = (NJDTrieNode *) malloc(size * sizeof(NJDTrieNode));
+   if (trie->node == NULL) {
+      fprintf(stderr, "ERROR: NJDTrie_initialize() in njd_trie.c: Cannot allocate memory.\n");
+      exit(1);
+   }
+   memset(trie->root, 0, sizeof(trie->root));
+   trie->size = 1;              /* node 0 stands for none */
+
+   for (i = 0; list[i] != NULL; i += num) {
+      p = (const unsigned char *) list[i];
+      if (*p == '\0')
+         continue;
+      if (trie->root[*p] == 0)
+         trie->root[*p] = NJDTrie_new_node(trie, *p, 0);
+      n = trie->root[*p];
+      for (p++; *p != '\0'; p++) {
+         for (link = &trie->node[n].child; *link != 0 && trie->node[*link].label < *p;
+              link = &trie->node[*link].sibling);
+         if (*link == 0 || trie->node[*link].label != *p)
+            *link = NJDTrie_new_node(trie, *p, *link);
+         n = *link;
+      }
+      if (trie->node[n].rule < 0)
+         trie->node[n].rule = i;
+   }
+}
+
+/* Return list index of the first rule whose pattern is head of 'str', or '-1'.
+   If 'exact' is true, the pattern must be equal to 'str'. */
+static int NJDTrie_search(NJDTrie * trie, const char *str, int *len, int exact)
+{
+   int i, n;
+   int rule = -1;
+
+   if (str == NULL)
+      return -1;
+   for (i = 0, n = trie->root[(unsigned char) str[0]]; n != 0;) {
+      i++;
+      if (trie->node[n].rule >= 0 && (exact == 0 || str[i] == '\0')
+          && (rule < 0 || trie->node[n].rule < rule)) {
+         rule = trie->node[n].rule;
+         if (len != NULL)
+            *len = i;
+      }
+      if (str[i] == '\0')
+         break;
+      for (n = trie->node[n].child; n != 0 && trie->node[n].label < (unsigned char) str[i];
+           n = trie->node[n].sibling);
+      if (n != 0 && trie->node[n].label != (unsigned char) str[i])
+         n = 0;
+   }
+   return rule;
+}
+
+/* Return list index of the first rule whose pattern is head of 'str', or '-1'.
+   Length of the pattern is set to 'len'. */
+int NJDTrie_find(NJDTrie * trie, const char *str, int *len)
+{
+   return NJDTrie_search(trie, str, len, 0);
+}
+
+/* Return list index of the first rule whose pattern is equal to 'str', or '-1'. */
+int NJDTrie_find_exact(NJDTrie * trie, const char *str)
+{
+   return NJDTrie_search(trie, str, NULL, 1);
+}
+
+void NJDTrie_clear(NJDTrie * trie)
+{
+   if (trie->node != NULL) {
+      free(trie->node);
+      trie->node = NULL;
+   }
+   trie->size = 0;
+}
+
+/* Call 'func' only on the first call with 'once'. Other threads calling it at the same time
+   return after 'func' has finished, so tables built by 'func' are complete when they are read. */
+void NJDOnce_call(NJDOnce * once, void (*func) (void))
+{
+#if defined(_WIN32) && !defined(__CYGWIN__)
+   if (InterlockedCompareExchange(once, 1, 0) == 0) {
+      func();
+      InterlockedExchange(once, 2);
+   } else {
+      while (InterlockedCompareExchange(once, 2, 2) != 2)
+         Sleep(0);
+   }
+#else
+   pthread_once(once, func);
+#endif                          /* _WIN32 && !__CYGWIN__ */
+}
+
+NJD_TRIE_C_END;
+
+#endif                          /* !NJD_TRIE_C */
@@ -68,76 +68,166 @@ NJD2JPCOMMON_C_START;
 #error CHARSET is not specified
 #endif
 
-#define MAXBUFLEN 1024
+/* size of the open addressing tables, power of two and larger than any rule list */
+#define NJD2JPCOMMON_HASH_SIZE 256
 
-static void convert_pos(char *buff, char *pos, char *pos_group1, char *pos_group2, char *pos_group3)
+/* rule lists are compiled once into hash tables from NJD fields to JPCommon IDs */
+typedef struct _NJD2JPCommonTable {
+   int slot[NJD2JPCOMMON_HASH_SIZE];    /* row + 1, or 0 for an empty slot */
+   int id[NJD2JPCOMMON_HASH_SIZE];      /* JPCommon ID of each row */
+} NJD2JPCommonTable;
+
+static NJD2JPCommonTable njd2jpcommon_pos_table;
+static NJD2JPCommonTable njd2jpcommon_ctype_table;
+static NJD2JPCommonTable njd2jpcommon_cform_table;
+static NJDOnce njd2jpcommon_table_once = NJD_ONCE_INIT;
+
+static unsigned int hash_string(unsigned int h, const char *str)
+{
+   /* FNV-1a, with a separator so that field boundaries are significant */
+   for (; *str != '\0'; str++)
+      h = (h ^ (unsigned char) *str) * 16777619U;
+   return (h ^ 0xffU) * 16777619U;
+}
+
+static unsigned int hash_fields(const char **fields, int num)
+{
+   int i;
+   unsigned int h = 2166136261U;
+
+   for (i = 0; i < num; i++)
+      h = hash_string(h, fields[i]);
+   return h;
+}
+
+static int match_fields(const char **row, const char **fields, int num)
 {
    int i;
 
-   for (i = 0; njd2jpcommon_pos_list[i] != NULL; i += 5) {
-      if (strcmp(njd2jpcommon_pos_list[i], pos) == 0 &&
-          strcmp(njd2jpcommon_pos_list[i + 1], pos_group1) == 0 &&
-          strcmp(njd2jpcommon_pos_list[i + 2], pos_group2) == 0 &&
-          strcmp(njd2jpcommon_pos_list[i + 3], pos_group3) == 0) {
-         strcpy(buff, njd2jpcommon_pos_list[i + 4]);
-         return;
+   for (i = 0; i < num; i++)
+      if (strcmp(row[i], fields[i]) != 0)
+         return 0;
+   return 1;
+}
+
+static void NJD2JPCommonTable_initialize(NJD2JPCommonTable * table, const char **list, int num,
+                                         int (*get_id) (const char *))
+{
+   int i, row;
+   unsigned int h;
+
+   memset(table->slot, 0, sizeof(table->slot));
+   for (i = 0, row = 0; list[i] != NULL; i += num + 1, row++) {
+      if (row >= NJD2JPCOMMON_HASH_SIZE / 2) {
+         fprintf(stderr,
+                 "ERROR: NJD2JPCommonTable_initialize() in njd2jpcommon.c: Too many rules.\n");
+         exit(1);
+      }
+      table->id[row] = get_id(list[i + num]);
+      if (table->id[row] < 0) {
+         fprintf(stderr,
+                 "WARNING: NJD2JPCommonTable_initialize() in njd2jpcommon.c: %s is unknown in JPCommon.\n",
+                 list[i + num]);
+         table->id[row] = 0;
+      }
+      for (h = hash_fields(&list[i], num);; h++) {
+         if (table->slot[h & (NJD2JPCOMMON_HASH_SIZE - 1)] == 0) {
+            table->slot[h & (NJD2JPCOMMON_HASH_SIZE - 1)] = row + 1;
+            break;
+         }
       }
    }
+}
+
+static void initialize_table(void)
+{
+   NJD2JPCommonTable_initialize(&njd2jpcommon_pos_table, njd2jpcommon_pos_list, 4,
+                                JPCommonLabel_get_pos_id);
+   NJD2JPCommonTable_initialize(&njd2jpcommon_ctype_table, njd2jpcommon_ctype_list, 1,
+                                JPCommonLabel_get_ctype_id);
+   NJD2JPCommonTable_initialize(&njd2jpcommon_cform_table, njd2jpcommon_cform_list, 1,
+                                JPCommonLabel_get_cform_id);
+}
+
+static int NJD2JPCommonTable_find(NJD2JPCommonTable * table, const char **list, int num,
+                                  const char **fields)
+{
+   int row;
+   unsigned int h;
+
+   for (h = hash_fields(fields, num);; h++) {
+      row = table->slot[h & (NJD2JPCOMMON_HASH_SIZE - 1)] - 1;
+      if (row < 0)
+         return -1;
+      if (match_fields(&list[row * (num + 1)], fields, num))
+         return table->id[row];
+   }
+}
+
+static int convert_pos(char *pos, char *pos_group1, char *pos_group2, char *pos_group3)
+{
+   int id;
+   const char *fields[4];
+
+   fields[0] = pos;
+   fields[1] = pos_group1;
+   fields[2] = pos_group2;
+   fields[3] = pos_group3;
+   id = NJD2JPCommonTable_find(&njd2jpcommon_pos_table, njd2jpcommon_pos_list, 4, fields);
+   if (id >= 0)
+      return id;
    fprintf(stderr,
            "WARING: convert_pos() in njd2jpcommon.c: %s %s %s %s are not appropriate POS.\n", pos,
            pos_group1, pos_group2, pos_group3);
-   strcpy(buff, njd2jpcommon_pos_list[4]);
+   return njd2jpcommon_pos_table.id[0];
 }
 
-static void convert_ctype(char *buff, char *ctype)
+static int convert_ctype(char *ctype)
 {
-   int i;
+   int id;
+   const char *fields[1];
 
-   for (i = 0; njd2jpcommon_ctype_list[i] != NULL; i += 2) {
-      if (strcmp(njd2jpcommon_ctype_list[i], ctype) == 0) {
-         strcpy(buff, njd2jpcommon_ctype_list[i + 1]);
-         return;
-      }
-   }
+   fields[0] = ctype;
+   id = NJD2JPCommonTable_find(&njd2jpcommon_ctype_table, njd2jpcommon_ctype_list, 1, fields);
+   if (id >= 0)
+      return id;
    fprintf(stderr,
            "WARING: convert_ctype() in njd2jpcommon.c: %s is not appropriate conjugation type.\n",
            ctype);
-   strcpy(buff, njd2jpcommon_ctype_list[1]);
+   return njd2jpcommon_ctype_table.id[0];
 }
 
-static void convert_cform(char *buff, char *cform)
+static int convert_cform(char *cform)
 {
-   int i;
+   int id;
+   const char *fields[1];
 
-   for (i = 0; njd2jpcommon_cform_list[i] != NULL; i += 2) {
-      if (strcmp(njd2jpcommon_cform_list[i], cform) == 0) {
-         strcpy(buff, njd2jpcommon_cform_list[i + 1]);
-         return;
-      }
-   }
+   fields[0] = cform;
+   id = NJD2JPCommonTable_find(&njd2jpcommon_cform_table, njd2jpcommon_cform_list, 1, fields);
+   if (id >= 0)
+      return id;
    fprintf(stderr,
            "WARING: convert_cform() in njd2jpcommon.c: %s is not appropriate conjugation form.\n",
            cform);
-   strcpy(buff, njd2jpcommon_cform_list[1]);
+   return njd2jpcommon_cform_table.id[0];
 }
 
 void njd2jpcommon(JPCommon * jpcommon, NJD * njd)
 {
-   char buff[MAXBUFLEN];
    NJDNode *inode;
    JPCommonNode *jnode;
 
+   NJDOnce_call(&njd2jpcommon_table_once, initialize_table);
    for (inode = njd->head; inode != NULL; inode = inode->next) {
       jnode = (JPCommonNode *) calloc(1, sizeof(JPCommonNode));
       JPCommonNode_initialize(jnode);
       JPCommonNode_set_pron(jnode, NJDNode_get_pron(inode));
-      convert_pos(buff, NJDNode_get_pos(inode), NJDNode_get_pos_group1(inode),
-                  NJDNode_get_pos_group2(inode), NJDNode_get_pos_group3(inode));
-      JPCommonNode_set_pos(jnode, buff);
-      convert_ctype(buff, NJDNode_get_ctype(inode));
-      JPCommonNode_set_ctype(jnode, buff);
-      convert_cform(buff, NJDNode_get_cform(inode));
-      JPCommonNode_set_cform(jnode, buff);
+      JPCommonNode_set_pos_id(jnode,
+                              convert_pos(NJDNode_get_pos(inode), NJDNode_get_pos_group1(inode),
+                                          NJDNode_get_pos_group2(inode),
+                                          NJDNode_get_pos_group3(inode)));
+      JPCommonNode_set_ctype_id(jnode, convert_ctype(NJDNode_get_ctype(inode)));
+      JPCommonNode_set_cform_id(jnode, convert_cform(NJDNode_get_cform(inode)));
       JPCommonNode_set_acc(jnode, NJDNode_get_acc(inode));
       JPCommonNode_set_chain_flag(jnode, NJDNode_get_chain_flag(inode));
       JPCommon_push(jpcommon, jnode);
@@ -0,0 +1,19 @@
+
+CC = cl
+
+CFLAGS = /O2 /Ob2 /Oi /Ot /Oy /GT /GL /TC /I ../njd /I ../njd_set_accent_phrase /I ../njd_set_accent_type /I ../njd_set_unvoiced_vowel /I ../njd_set_long_vowel
+LFLAGS = /LTCG
+
+CORES = njd_set_accent_and_vowel.obj
+
+all: njd_set_accent_and_vowel.lib
+
+njd_set_accent_and_vowel.lib: $(CORES)
+	lib $(LFLAGS) /OUT:$@ $(CORES)
+
+.c.obj:
+	$(CC) $(CFLAGS) /c $<
+
+clean:
+	del *.lib
+	del *.obj
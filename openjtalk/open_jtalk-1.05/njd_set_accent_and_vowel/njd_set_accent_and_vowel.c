@@ -0,0 +1,99 @@
+/* ----------------------------------------------------------------- */
+/*           The Japanese TTS System "Open JTalk"                    */
+/*           developed by HTS Working Group                          */
+/*           http://open-jtalk.sourceforge.net/                      */
+/* ----------------------------------------------------------------- */
+/*                                                                   */
+/*  Copyright (c) 2008-2011  Nagoya Institute of Technology          */
+/*                           Department of Computer Science          */
+/*                                                                   */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/* - Redistributions of source code must retain the above copyright  */
+/*   notice, this list of conditions and the following disclaimer.   */
+/* - Redistributions in binary form must reproduce the above         */
+/*   copyright notice, this list of conditions and the following     */
+/*   disclaimer in the documentation and/or other materials provided */
+/*   with the distribution.                                          */
+/* - Neither the name of the HTS working group nor the names of its  */
+/*   contributors may be used to endorse or promote products derived */
+/*   from this software without specific prior written permission.   */
+/*                                                                   */
+/* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND            */
+/* CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,       */
+/* INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF          */
+/* MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE          */
+/* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS */
+/* BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,          */
+/* EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED   */
+/* TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,     */
+/* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON */
+/* ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,   */
+/* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY    */
+/* OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE           */
+/* POSSIBILITY OF SUCH DAMAGE.                                       */
+/* ----------------------------------------------------------------- */
+
+#ifndef NJD_SET_ACCENT_AND_VOWEL_C
+#define NJD_SET_ACCENT_AND_VOWEL_C
+
+#ifdef __cplusplus
+#define NJD_SET_ACCENT_AND_VOWEL_C_START extern "C" {
+#define NJD_SET_ACCENT_AND_VOWEL_C_END   }
+#else
+#define NJD_SET_ACCENT_AND_VOWEL_C_START
+#define NJD_SET_ACCENT_AND_VOWEL_C_END
+#endif                          /* __CPLUSPLUS */
+
+NJD_SET_ACCENT_AND_VOWEL_C_START;
+
+#include <stdio.h>
+
+#include "njd.h"
+#include "njd_set_accent_phrase.h"
+#include "njd_set_accent_type.h"
+#include "njd_set_unvoiced_vowel.h"
+#include "njd_set_long_vowel.h"
+#include "njd_set_accent_and_vowel.h"
+
+/* same as njd_set_accent_phrase(), njd_set_accent_type(), njd_set_unvoiced_vowel() and
+   njd_set_long_vowel() in this order, but in a single traversal */
+void njd_set_accent_and_vowel(NJD * njd)
+{
+   NJDNode *node;
+   NJDNode *voiced;             /* first node which is not processed by vowel passes */
+   NJDSetAccentPhrase accent_phrase;
+   NJDSetAccentType accent_type;
+   NJDSetUnvoicedVowel unvoiced_vowel;
+
+   if (njd->head == NULL)
+      return;
+   njd_set_accent_phrase_initialize(&accent_phrase);
+   njd_set_accent_type_initialize(&accent_type);
+   njd_set_unvoiced_vowel_initialize(&unvoiced_vowel);
+
+   voiced = njd->head;
+   for (node = njd->head; node != NULL; node = node->next) {
+      njd_set_accent_phrase_node(node, &accent_phrase);
+      /* accent types before the top of a new accent phrase are fixed */
+      if (njd_set_accent_type_node(njd, node, &accent_type) == 1) {
+         for (; voiced != node; voiced = voiced->next) {
+            njd_set_unvoiced_vowel_node(voiced, &unvoiced_vowel);
+            njd_set_long_vowel_node(voiced);
+         }
+      }
+   }
+   for (; voiced != NULL; voiced = voiced->next) {
+      njd_set_unvoiced_vowel_node(voiced, &unvoiced_vowel);
+      njd_set_long_vowel_node(voiced);
+   }
+   njd_set_unvoiced_vowel_clear(&unvoiced_vowel);
+}
+
+NJD_SET_ACCENT_AND_VOWEL_C_END;
+
+#endif                          /* !NJD_SET_ACCENT_AND_VOWEL_C */
@@ -67,153 +67,201 @@ NJD_SET_ACCENT_PHRASE_C_START;
 #error CHARSET is not specified
 #endif
 
-static int strtopcmp(char *str, const char *pattern)
+/* POS IDs */
+#define NJD_SET_ACCENT_PHRASE_POS_OTHER        0
+#define NJD_SET_ACCENT_PHRASE_POS_MEISHI       1
+#define NJD_SET_ACCENT_PHRASE_POS_KEIYOUSHI    2
+#define NJD_SET_ACCENT_PHRASE_POS_DOUSHI       3
+#define NJD_SET_ACCENT_PHRASE_POS_FUKUSHI      4
+#define NJD_SET_ACCENT_PHRASE_POS_SETSUZOKUSHI 5
+#define NJD_SET_ACCENT_PHRASE_POS_RENTAISHI    6
+#define NJD_SET_ACCENT_PHRASE_POS_JODOUSHI     7
+#define NJD_SET_ACCENT_PHRASE_POS_JOSHI        8
+#define NJD_SET_ACCENT_PHRASE_POS_KIGOU        9
+#define NJD_SET_ACCENT_PHRASE_POS_SETTOUSHI    10
+
+/* POS group1 IDs */
+#define NJD_SET_ACCENT_PHRASE_GROUP1_OTHER             0
+#define NJD_SET_ACCENT_PHRASE_GROUP1_KEIYOUDOUSHI_GOKAN 1
+#define NJD_SET_ACCENT_PHRASE_GROUP1_FUKUSHI_KANOU     2
+#define NJD_SET_ACCENT_PHRASE_GROUP1_SETSUBI           3
+#define NJD_SET_ACCENT_PHRASE_GROUP1_HIJIRITSU         4
+#define NJD_SET_ACCENT_PHRASE_GROUP1_SETSUZOKUJOSHI    5
+#define NJD_SET_ACCENT_PHRASE_GROUP1_SAHEN_SETSUZOKU   6
+
+/* listed in order of IDs, starting from 1 */
+static const char *njd_set_accent_phrase_pos_list[] = {
+   NJD_SET_ACCENT_PHRASE_MEISHI,
+   NJD_SET_ACCENT_PHRASE_KEIYOUSHI,
+   NJD_SET_ACCENT_PHRASE_DOUSHI,
+   NJD_SET_ACCENT_PHRASE_FUKUSHI,
+   NJD_SET_ACCENT_PHRASE_SETSUZOKUSHI,
+   NJD_SET_ACCENT_PHRASE_RENTAISHI,
+   NJD_SET_ACCENT_PHRASE_JODOUSHI,
+   NJD_SET_ACCENT_PHRASE_JOSHI,
+   NJD_SET_ACCENT_PHRASE_KIGOU,
+   NJD_SET_ACCENT_PHRASE_SETTOUSHI,
+   NULL
+};
+
+static const char *njd_set_accent_phrase_group1_list[] = {
+   NJD_SET_ACCENT_PHRASE_KEIYOUDOUSHI_GOKAN,
+   NJD_SET_ACCENT_PHRASE_FUKUSHI_KANOU,
+   NJD_SET_ACCENT_PHRASE_SETSUBI,
+   NJD_SET_ACCENT_PHRASE_HIJIRITSU,
+   NJD_SET_ACCENT_PHRASE_SETSUZOKUJOSHI,
+   NJD_SET_ACCENT_PHRASE_SAHEN_SETSUZOKU,
+   NULL
+};
+
+static NJDTrie njd_set_accent_phrase_pos_trie;
+static NJDTrie njd_set_accent_phrase_group1_trie;
+static NJDOnce njd_set_accent_phrase_trie_once = NJD_ONCE_INIT;
+
+static void get_class(NJDNode * node, NJDSetAccentPhraseClass * c)
+{
+   const char *str;
+
+   c->pos = NJDTrie_find_exact(&njd_set_accent_phrase_pos_trie, NJDNode_get_pos(node)) + 1;
+   c->group1 =
+       NJDTrie_find_exact(&njd_set_accent_phrase_group1_trie, NJDNode_get_pos_group1(node)) + 1;
+   /* empty fields are NULL, e.g. string of the following units of a multi-unit word */
+   str = NJDNode_get_cform(node);
+   c->renyou = (str != NULL && strncmp(str, NJD_SET_ACCENT_PHRASE_RENYOU,
+                                       strlen(NJD_SET_ACCENT_PHRASE_RENYOU)) == 0) ? 1 : 0;
+   str = NJDNode_get_string(node);
+   c->te = (str != NULL && (strcmp(str, NJD_SET_ACCENT_PHRASE_TE) == 0
+                            || strcmp(str, NJD_SET_ACCENT_PHRASE_DE) == 0)) ? 1 : 0;
+}
+
+static int get_chain_flag(const NJDSetAccentPhraseClass * p, const NJDSetAccentPhraseClass * c)
 {
-   int i;
-
-   for (i = 0;; i++) {
-      if (pattern[i] == '\0')
-         return i;
-      if (str[i] == '\0')
-         return -1;
-      if (str[i] != pattern[i])
-         return -1;
+   /* Rule 01 */
+   int flag = 1;
+
+   /* Rule 02 */
+   if (p->pos == NJD_SET_ACCENT_PHRASE_POS_MEISHI && c->pos == NJD_SET_ACCENT_PHRASE_POS_MEISHI)
+      flag = 1;
+
+   /* Rule 03 */
+   if (p->pos == NJD_SET_ACCENT_PHRASE_POS_KEIYOUSHI && c->pos == NJD_SET_ACCENT_PHRASE_POS_MEISHI)
+      flag = 0;
+
+   /* Rule 04 */
+   if (p->pos == NJD_SET_ACCENT_PHRASE_POS_MEISHI
+       && p->group1 == NJD_SET_ACCENT_PHRASE_GROUP1_KEIYOUDOUSHI_GOKAN
+       && c->pos == NJD_SET_ACCENT_PHRASE_POS_MEISHI)
+      flag = 0;
+
+   /* Rule 05 */
+   if (p->pos == NJD_SET_ACCENT_PHRASE_POS_DOUSHI
+       && (c->pos == NJD_SET_ACCENT_PHRASE_POS_KEIYOUSHI
+           || c->pos == NJD_SET_ACCENT_PHRASE_POS_MEISHI))
+      flag = 0;
+
+   /* Rule 06 */
+   if (c->pos == NJD_SET_ACCENT_PHRASE_POS_FUKUSHI || p->pos == NJD_SET_ACCENT_PHRASE_POS_FUKUSHI
+       || c->pos == NJD_SET_ACCENT_PHRASE_POS_SETSUZOKUSHI
+       || p->pos == NJD_SET_ACCENT_PHRASE_POS_SETSUZOKUSHI
+       || c->pos == NJD_SET_ACCENT_PHRASE_POS_RENTAISHI
+       || p->pos == NJD_SET_ACCENT_PHRASE_POS_RENTAISHI)
+      flag = 0;
+
+   /* Rule 07 */
+   if (p->pos == NJD_SET_ACCENT_PHRASE_POS_MEISHI
+       && p->group1 == NJD_SET_ACCENT_PHRASE_GROUP1_FUKUSHI_KANOU)
+      flag = 0;
+   if (c->pos == NJD_SET_ACCENT_PHRASE_POS_MEISHI
+       && c->group1 == NJD_SET_ACCENT_PHRASE_GROUP1_FUKUSHI_KANOU)
+      flag = 0;
+
+   /* Rule 08 */
+   if (c->pos == NJD_SET_ACCENT_PHRASE_POS_JODOUSHI || c->pos == NJD_SET_ACCENT_PHRASE_POS_JOSHI)
+      flag = 1;
+
+   /* Rule 09 */
+   if ((p->pos == NJD_SET_ACCENT_PHRASE_POS_JODOUSHI || p->pos == NJD_SET_ACCENT_PHRASE_POS_JOSHI)
+       && c->pos != NJD_SET_ACCENT_PHRASE_POS_JODOUSHI && c->pos != NJD_SET_ACCENT_PHRASE_POS_JOSHI)
+      flag = 0;
+
+   /* Rule 10 */
+   if (p->group1 == NJD_SET_ACCENT_PHRASE_GROUP1_SETSUBI
+       && c->pos == NJD_SET_ACCENT_PHRASE_POS_MEISHI)
+      flag = 0;
+
+   /* Rule 11 */
+   if (c->pos == NJD_SET_ACCENT_PHRASE_POS_KEIYOUSHI
+       && c->group1 == NJD_SET_ACCENT_PHRASE_GROUP1_HIJIRITSU) {
+      if (p->pos == NJD_SET_ACCENT_PHRASE_POS_DOUSHI
+          || p->pos == NJD_SET_ACCENT_PHRASE_POS_KEIYOUSHI) {
+         if (p->renyou)
+            flag = 1;
+      } else if (p->pos == NJD_SET_ACCENT_PHRASE_POS_JOSHI) {
+         if (p->group1 == NJD_SET_ACCENT_PHRASE_GROUP1_SETSUZOKUJOSHI && p->te)
+            flag = 1;
+      }
+   }
+
+   /* Rule 12 */
+   if (c->pos == NJD_SET_ACCENT_PHRASE_POS_DOUSHI
+       && c->group1 != NJD_SET_ACCENT_PHRASE_GROUP1_HIJIRITSU) {
+      if (p->pos == NJD_SET_ACCENT_PHRASE_POS_DOUSHI) {
+         if (p->renyou)
+            flag = 1;
+      } else if (p->pos == NJD_SET_ACCENT_PHRASE_POS_MEISHI) {
+         if (p->group1 == NJD_SET_ACCENT_PHRASE_GROUP1_SAHEN_SETSUZOKU)
+            flag = 1;
+      } else if (p->pos == NJD_SET_ACCENT_PHRASE_POS_JOSHI) {
+         if (p->group1 == NJD_SET_ACCENT_PHRASE_GROUP1_SETSUZOKUJOSHI && p->te)
+            flag = 1;
+      }
    }
+
+   /* Rule 13 */
+   if (c->pos == NJD_SET_ACCENT_PHRASE_POS_KIGOU || p->pos == NJD_SET_ACCENT_PHRASE_POS_KIGOU)
+      flag = 0;
+
+   /* Rule 14 */
+   if (c->pos == NJD_SET_ACCENT_PHRASE_POS_SETTOUSHI)
+      flag = 0;
+
+   return flag;
 }
 
+static void initialize_trie(void)
+{
+   NJDTrie_initialize(&njd_set_accent_phrase_pos_trie, njd_set_accent_phrase_pos_list, 1);
+   NJDTrie_initialize(&njd_set_accent_phrase_group1_trie, njd_set_accent_phrase_group1_list, 1);
+}
 
 void njd_set_accent_phrase(NJD * njd)
 {
    NJDNode *node;
+   NJDSetAccentPhrase s;
 
    if (njd->head == NULL)
       return;
+   njd_set_accent_phrase_initialize(&s);
+   for (node = njd->head; node != NULL; node = node->next)
+      njd_set_accent_phrase_node(node, &s);
+}
 
-   for (node = njd->head->next; node != NULL; node = node->next) {
-      if (NJDNode_get_chain_flag(node) < 0) {
-         /* Rule 01 */
-         NJDNode_set_chain_flag(node, 1);
-
-         /* Rule 02 */
-         if (strcmp(NJDNode_get_pos(node->prev), NJD_SET_ACCENT_PHRASE_MEISHI) == 0)
-            if (strcmp(NJDNode_get_pos(node), NJD_SET_ACCENT_PHRASE_MEISHI) == 0)
-               NJDNode_set_chain_flag(node, 1);
-
-         /* Rule 03 */
-         if (strcmp(NJDNode_get_pos(node->prev), NJD_SET_ACCENT_PHRASE_KEIYOUSHI) == 0)
-            if (strcmp(NJDNode_get_pos(node), NJD_SET_ACCENT_PHRASE_MEISHI) == 0)
-               NJDNode_set_chain_flag(node, 0);
-
-         /* Rule 04 */
-         if (strcmp(NJDNode_get_pos(node->prev), NJD_SET_ACCENT_PHRASE_MEISHI) == 0)
-            if (strcmp
-                (NJDNode_get_pos_group1(node->prev), NJD_SET_ACCENT_PHRASE_KEIYOUDOUSHI_GOKAN) == 0)
-               if (strcmp(NJDNode_get_pos(node), NJD_SET_ACCENT_PHRASE_MEISHI) == 0)
-                  NJDNode_set_chain_flag(node, 0);
-
-         /* Rule 05 */
-         if (strcmp(NJDNode_get_pos(node->prev), NJD_SET_ACCENT_PHRASE_DOUSHI) == 0) {
-            if (strcmp(NJDNode_get_pos(node), NJD_SET_ACCENT_PHRASE_KEIYOUSHI) == 0)
-               NJDNode_set_chain_flag(node, 0);
-            else if (strcmp(NJDNode_get_pos(node), NJD_SET_ACCENT_PHRASE_MEISHI) == 0)
-               NJDNode_set_chain_flag(node, 0);
-         }
-
-         /* Rule 06 */
-         if (strcmp(NJDNode_get_pos(node), NJD_SET_ACCENT_PHRASE_FUKUSHI) == 0
-             || strcmp(NJDNode_get_pos(node->prev), NJD_SET_ACCENT_PHRASE_FUKUSHI) == 0
-             || strcmp(NJDNode_get_pos(node), NJD_SET_ACCENT_PHRASE_SETSUZOKUSHI) == 0
-             || strcmp(NJDNode_get_pos(node->prev), NJD_SET_ACCENT_PHRASE_SETSUZOKUSHI) == 0
-             || strcmp(NJDNode_get_pos(node), NJD_SET_ACCENT_PHRASE_RENTAISHI) == 0
-             || strcmp(NJDNode_get_pos(node->prev), NJD_SET_ACCENT_PHRASE_RENTAISHI) == 0)
-            NJDNode_set_chain_flag(node, 0);
-
-         /* Rule 07 */
-         if (strcmp(NJDNode_get_pos(node->prev), NJD_SET_ACCENT_PHRASE_MEISHI) == 0)
-            if (strcmp(NJDNode_get_pos_group1(node->prev), NJD_SET_ACCENT_PHRASE_FUKUSHI_KANOU)
-                == 0)
-               NJDNode_set_chain_flag(node, 0);
-         if (strcmp(NJDNode_get_pos(node), NJD_SET_ACCENT_PHRASE_MEISHI) == 0)
-            if (strcmp(NJDNode_get_pos_group1(node), NJD_SET_ACCENT_PHRASE_FUKUSHI_KANOU) == 0)
-               NJDNode_set_chain_flag(node, 0);
-
-         /* Rule 08 */
-         if (strcmp(NJDNode_get_pos(node), NJD_SET_ACCENT_PHRASE_JODOUSHI) == 0)
-            NJDNode_set_chain_flag(node, 1);
-         if (strcmp(NJDNode_get_pos(node), NJD_SET_ACCENT_PHRASE_JOSHI) == 0)
-            NJDNode_set_chain_flag(node, 1);
-
-         /* Rule 09 */
-         if (strcmp(NJDNode_get_pos(node->prev), NJD_SET_ACCENT_PHRASE_JODOUSHI) == 0)
-            if (strcmp(NJDNode_get_pos(node), NJD_SET_ACCENT_PHRASE_JODOUSHI) != 0 &&
-                strcmp(NJDNode_get_pos(node), NJD_SET_ACCENT_PHRASE_JOSHI) != 0)
-               NJDNode_set_chain_flag(node, 0);
-         if (strcmp(NJDNode_get_pos(node->prev), NJD_SET_ACCENT_PHRASE_JOSHI) == 0)
-            if (strcmp(NJDNode_get_pos(node), NJD_SET_ACCENT_PHRASE_JODOUSHI) != 0 &&
-                strcmp(NJDNode_get_pos(node), NJD_SET_ACCENT_PHRASE_JOSHI) != 0)
-               NJDNode_set_chain_flag(node, 0);
-
-         /* Rule 10 */
-         if (strcmp(NJDNode_get_pos_group1(node->prev), NJD_SET_ACCENT_PHRASE_SETSUBI) == 0)
-            if (strcmp(NJDNode_get_pos(node), NJD_SET_ACCENT_PHRASE_MEISHI) == 0)
-               NJDNode_set_chain_flag(node, 0);
-
-         /* Rule 11 */
-         if (strcmp(NJDNode_get_pos(node), NJD_SET_ACCENT_PHRASE_KEIYOUSHI) == 0)
-            if (strcmp(NJDNode_get_pos_group1(node), NJD_SET_ACCENT_PHRASE_HIJIRITSU) == 0) {
-               if (strcmp(NJDNode_get_pos(node->prev), NJD_SET_ACCENT_PHRASE_DOUSHI) == 0) {
-                  if (strtopcmp(NJDNode_get_cform(node->prev), NJD_SET_ACCENT_PHRASE_RENYOU) != -1)
-                     NJDNode_set_chain_flag(node, 1);
-               } else if (strcmp(NJDNode_get_pos(node->prev), NJD_SET_ACCENT_PHRASE_KEIYOUSHI)
-                          == 0) {
-                  if (strtopcmp(NJDNode_get_cform(node->prev), NJD_SET_ACCENT_PHRASE_RENYOU) != -1)
-                     NJDNode_set_chain_flag(node, 1);
-               } else if (strcmp(NJDNode_get_pos(node->prev), NJD_SET_ACCENT_PHRASE_JOSHI) == 0) {
-                  if (strcmp
-                      (NJDNode_get_pos_group1(node->prev),
-                       NJD_SET_ACCENT_PHRASE_SETSUZOKUJOSHI) == 0) {
-                     if (strcmp(NJDNode_get_string(node->prev), NJD_SET_ACCENT_PHRASE_TE) == 0)
-                        NJDNode_set_chain_flag(node, 1);
-                     else if (strcmp(NJDNode_get_string(node->prev), NJD_SET_ACCENT_PHRASE_DE) == 0)
-                        NJDNode_set_chain_flag(node, 1);
-                  }
-               }
-            }
-
-         /* Rule 12 */
-         if (strcmp(NJDNode_get_pos(node), NJD_SET_ACCENT_PHRASE_DOUSHI) == 0)
-            if (strcmp(NJDNode_get_pos_group1(node), NJD_SET_ACCENT_PHRASE_HIJIRITSU)) {
-               if (strcmp(NJDNode_get_pos(node->prev), NJD_SET_ACCENT_PHRASE_DOUSHI) == 0) {
-                  if (strtopcmp(NJDNode_get_cform(node->prev), NJD_SET_ACCENT_PHRASE_RENYOU) != -1)
-                     NJDNode_set_chain_flag(node, 1);
-               } else if (strcmp(NJDNode_get_pos(node->prev), NJD_SET_ACCENT_PHRASE_MEISHI) == 0) {
-                  if (strcmp
-                      (NJDNode_get_pos_group1(node->prev),
-                       NJD_SET_ACCENT_PHRASE_SAHEN_SETSUZOKU) == 0)
-                     NJDNode_set_chain_flag(node, 1);
-               } else if (strcmp(NJDNode_get_pos(node->prev), NJD_SET_ACCENT_PHRASE_JOSHI) == 0) {
-                  if (strcmp
-                      (NJDNode_get_pos_group1(node->prev),
-                       NJD_SET_ACCENT_PHRASE_SETSUZOKUJOSHI) == 0) {
-                     if (strcmp(NJDNode_get_string(node->prev), NJD_SET_ACCENT_PHRASE_TE) == 0)
-                        NJDNode_set_chain_flag(node, 1);
-                     else if (strcmp(NJDNode_get_string(node->prev), NJD_SET_ACCENT_PHRASE_DE)
-                              == 0)
-                        NJDNode_set_chain_flag(node, 1);
-                  }
-               }
-            }
-
-         /* Rule 13 */
-         if (strcmp(NJDNode_get_pos(node), NJD_SET_ACCENT_PHRASE_KIGOU) == 0 ||
-             strcmp(NJDNode_get_pos(node->prev), NJD_SET_ACCENT_PHRASE_KIGOU) == 0)
-            NJDNode_set_chain_flag(node, 0);
-
-         /* Rule 14 */
-         if (strcmp(NJDNode_get_pos(node), NJD_SET_ACCENT_PHRASE_SETTOUSHI) == 0)
-            NJDNode_set_chain_flag(node, 0);
-      }
-   }
+void njd_set_accent_phrase_initialize(NJDSetAccentPhrase * s)
+{
+   NJDOnce_call(&njd_set_accent_phrase_trie_once, initialize_trie);
+   s->has_prev = 0;
+}
+
+void njd_set_accent_phrase_node(NJDNode * node, NJDSetAccentPhrase * s)
+{
+   NJDSetAccentPhraseClass c;
+
+   /* each node is interned once and its class is reused as the previous one */
+   get_class(node, &c);
+   if (s->has_prev && NJDNode_get_chain_flag(node) < 0)
+      NJDNode_set_chain_flag(node, get_chain_flag(&s->prev, &c));
+   s->prev = c;
+   s->has_prev = 1;
 }
 
 NJD_SET_ACCENT_PHRASE_C_END;
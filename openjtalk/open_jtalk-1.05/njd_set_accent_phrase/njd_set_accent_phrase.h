@@ -51,8 +51,26 @@
 
 NJD_SET_ACCENT_PHRASE_H_START;
 
+/* node features referred by rules, interned once per node */
+typedef struct _NJDSetAccentPhraseClass {
+   int pos;
+   int group1;
+   int renyou;                  /* cform starts with RENYOU */
+   int te;                      /* string is TE or DE */
+} NJDSetAccentPhraseClass;
+
+/* state carried from a node to the next one */
+typedef struct _NJDSetAccentPhrase {
+   NJDSetAccentPhraseClass prev;        /* class of the previous node */
+   int has_prev;
+} NJDSetAccentPhrase;
+
 void njd_set_accent_phrase(NJD * njd);
 
+void njd_set_accent_phrase_initialize(NJDSetAccentPhrase * s);
+
+void njd_set_accent_phrase_node(NJDNode * node, NJDSetAccentPhrase * s);
+
 NJD_SET_ACCENT_PHRASE_H_END;
 
 #endif                          /* !NJD_SET_ACCENT_PHRASE_H */
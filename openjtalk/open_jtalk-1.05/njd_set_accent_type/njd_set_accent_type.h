@@ -51,8 +51,18 @@
 
 NJD_SET_ACCENT_TYPE_H_START;
 
+/* state carried from a node to the next one */
+typedef struct _NJDSetAccentType {
+   NJDNode *top_node;           /* top node of the current accent phrase */
+   int mora_size;               /* mora size before the current node in the accent phrase */
+} NJDSetAccentType;
+
 void njd_set_accent_type(NJD * njd);
 
+void njd_set_accent_type_initialize(NJDSetAccentType * s);
+
+int njd_set_accent_type_node(NJD * njd, NJDNode * node, NJDSetAccentType * s);
+
 NJD_SET_ACCENT_TYPE_H_END;
 
 #endif                          /* !NJD_SET_ACCENT_TYPE_H */
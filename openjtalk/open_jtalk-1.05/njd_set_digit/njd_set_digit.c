@@ -70,18 +70,96 @@ NJD_SET_DIGIT_C_START;
 
 #define MAXBUFLEN 1024
 
-static int strtopcmp(char *str, const char *pattern)
+/* numerative classes in order of priority, and conversion tables for each of them */
+static const char **njd_set_digit_numerative_class1[] = {
+   njd_set_digit_rule_numerative_class1b,
+   njd_set_digit_rule_numerative_class1c,
+   njd_set_digit_rule_numerative_class1d,
+   njd_set_digit_rule_numerative_class1e,
+   njd_set_digit_rule_numerative_class1f,
+   njd_set_digit_rule_numerative_class1g,
+   njd_set_digit_rule_numerative_class1h,
+   njd_set_digit_rule_numerative_class1i,
+   njd_set_digit_rule_numerative_class1j,
+   njd_set_digit_rule_numerative_class1k,
+   NULL
+};
+
+static const char **njd_set_digit_conv_table1[] = {
+   njd_set_digit_rule_conv_table1b,
+   njd_set_digit_rule_conv_table1c,
+   njd_set_digit_rule_conv_table1d,
+   njd_set_digit_rule_conv_table1e,
+   njd_set_digit_rule_conv_table1f,
+   njd_set_digit_rule_conv_table1g,
+   njd_set_digit_rule_conv_table1h,
+   njd_set_digit_rule_conv_table1i,
+   njd_set_digit_rule_conv_table1j,
+   njd_set_digit_rule_conv_table1k
+};
+
+static const char **njd_set_digit_numerative_class2[] = {
+   njd_set_digit_rule_numerative_class2b,
+   njd_set_digit_rule_numerative_class2c,
+   njd_set_digit_rule_numerative_class2d,
+   njd_set_digit_rule_numerative_class2e,
+   njd_set_digit_rule_numerative_class2f,
+   NULL
+};
+
+static const char **njd_set_digit_conv_table2[] = {
+   njd_set_digit_rule_conv_table2b,
+   njd_set_digit_rule_conv_table2c,
+   njd_set_digit_rule_conv_table2d,
+   njd_set_digit_rule_conv_table2e,
+   njd_set_digit_rule_conv_table2f
+};
+
+/* numerative classes merged into one trie, which gives the first class having a string */
+typedef struct _NJDSetDigitClass {
+   NJDTrie trie;
+   const char **list;           /* strings of all classes */
+   int *id;                     /* class of each string */
+} NJDSetDigitClass;
+
+static NJDTrie njd_set_digit_numeral_trie;
+static NJDTrie njd_set_digit_numeral_list4_trie;
+static NJDTrie njd_set_digit_numeral_list5_trie;
+static NJDSetDigitClass njd_set_digit_class1;
+static NJDSetDigitClass njd_set_digit_class2;
+
+static void initialize_class(NJDSetDigitClass * c, const char **class_list[])
+{
+   int i, j, n;
+
+   for (i = 0, n = 0; class_list[i] != NULL; i++)
+      for (j = 0; class_list[i][j] != NULL; j++)
+         n++;
+   c->list = (const char **) malloc((n + 1) * sizeof(const char *));
+   c->id = (int *) malloc((n + 1) * sizeof(int));
+   if (c->list == NULL || c->id == NULL) {
+      fprintf(stderr, "ERROR: initialize_class() in njd_set_digit.c: Cannot allocate memory.\n");
+      exit(1);
+   }
+   for (i = 0, n = 0; class_list[i] != NULL; i++) {
+      for (j = 0; class_list[i][j] != NULL; j++, n++) {
+         c->list[n] = class_list[i][j];
+         c->id[n] = i;
+      }
+   }
+   c->list[n] = NULL;
+   NJDTrie_initialize(&c->trie, c->list, 1);
+}
+
+/* Return index of the first class which has string of 'node', or '-1'. */
+static int search_class(NJDSetDigitClass * c, NJDNode * node)
 {
    int i;
 
-   for (i = 0;; i++) {
-      if (pattern[i] == '\0')
-         return i;
-      if (str[i] == '\0')
-         return -1;
-      if (str[i] != pattern[i])
-         return -1;
-   }
+   i = NJDTrie_find_exact(&c->trie, NJDNode_get_string(node));
+   if (i < 0)
+      return -1;
+   return c->id[i];
 }
 
 static int get_digit(NJDNode * node, int convert_flag)
@@ -91,15 +169,16 @@ static int get_digit(NJDNode * node, int convert_flag)
    if (NJDNode_get_string(node) == NULL)
       return -1;
 
-   if (strcmp(NJDNode_get_pos_group1(node), NJD_SET_DIGIT_KAZU) == 0)
-      for (i = 0; njd_set_digit_rule_numeral_list1[i] != NULL; i += 3)
-         if (strcmp(njd_set_digit_rule_numeral_list1[i], NJDNode_get_string(node)) == 0) {
-            if (convert_flag == 1) {
-               NJDNode_set_string(node, (char *) njd_set_digit_rule_numeral_list1[i + 2]);
-               NJDNode_set_orig(node, (char *) njd_set_digit_rule_numeral_list1[i + 2]);
-            }
-            return atoi(njd_set_digit_rule_numeral_list1[i + 1]);
+   if (strcmp(NJDNode_get_pos_group1(node), NJD_SET_DIGIT_KAZU) == 0) {
+      i = NJDTrie_find_exact(&njd_set_digit_numeral_trie, NJDNode_get_string(node));
+      if (i >= 0) {
+         if (convert_flag == 1) {
+            NJDNode_set_string(node, (char *) njd_set_digit_rule_numeral_list1[i + 2]);
+            NJDNode_set_orig(node, (char *) njd_set_digit_rule_numeral_list1[i + 2]);
          }
+         return atoi(njd_set_digit_rule_numeral_list1[i + 1]);
+      }
+   }
 
    return -1;
 }
@@ -173,7 +252,7 @@ static int get_digit_sequence_score(NJDNode * start, NJDNode * end)
    return score;
 }
 
-static void convert_digit_sequence(NJDNode * start, NJDNode * end)
+static void convert_digit_sequence(NJD * njd, NJDNode * start, NJDNode * end)
 {
    NJDNode *node;
    NJDNode *newnode;
@@ -233,8 +312,7 @@ static void convert_digit_sequence(NJDNode * start, NJDNode * end)
          }
          if (have == 1) {
             if (place > 0) {
-               newnode = (NJDNode *) calloc(1, sizeof(NJDNode));
-               NJDNode_initialize(newnode);
+               newnode = NJD_new_node(njd);
                NJDNode_load(newnode, (char *) njd_set_digit_rule_numeral_list3[place]);
                node = NJDNode_insert(node, node->next, newnode);
             }
@@ -248,8 +326,7 @@ static void convert_digit_sequence(NJDNode * start, NJDNode * end)
             NJDNode_set_mora_size(node, 0);
          }
          if (digit > 0) {
-            newnode = (NJDNode *) calloc(1, sizeof(NJDNode));
-            NJDNode_initialize(newnode);
+            newnode = NJD_new_node(njd);
             NJDNode_load(newnode, (char *) njd_set_digit_rule_numeral_list2[index]);
             node = NJDNode_insert(node, node->next, newnode);
             have = 1;
@@ -292,6 +369,23 @@ static void convert_digit_pron(const char *list[], NJDNode * node)
    }
 }
 
+static NJDTrie njd_set_digit_voiced_sound_symbol_trie;
+static NJDTrie njd_set_digit_semivoiced_sound_symbol_trie;
+static NJDOnce njd_set_digit_trie_once = NJD_ONCE_INIT;
+
+static void initialize_trie(void)
+{
+   NJDTrie_initialize(&njd_set_digit_voiced_sound_symbol_trie,
+                      njd_set_digit_rule_voiced_sound_symbol_list, 2);
+   NJDTrie_initialize(&njd_set_digit_semivoiced_sound_symbol_trie,
+                      njd_set_digit_rule_semivoiced_sound_symbol_list, 2);
+   NJDTrie_initialize(&njd_set_digit_numeral_trie, njd_set_digit_rule_numeral_list1, 3);
+   NJDTrie_initialize(&njd_set_digit_numeral_list4_trie, njd_set_digit_rule_numeral_list4, 1);
+   NJDTrie_initialize(&njd_set_digit_numeral_list5_trie, njd_set_digit_rule_numeral_list5, 1);
+   initialize_class(&njd_set_digit_class1, njd_set_digit_numerative_class1);
+   initialize_class(&njd_set_digit_class2, njd_set_digit_numerative_class2);
+}
+
 static void convert_numerative_pron(const char *list[], NJDNode * node1, NJDNode * node2)
 {
    int i, j;
@@ -308,26 +402,20 @@ static void convert_numerative_pron(const char *list[], NJDNode * node1, NJDNode
       }
    }
    if (type == 1) {
-      for (i = 0; njd_set_digit_rule_voiced_sound_symbol_list[i] != NULL; i += 2) {
-         str = NJDNode_get_pron(node2);
-         j = strtopcmp(str, njd_set_digit_rule_voiced_sound_symbol_list[i]);
-         if (j >= 0) {
-            strcpy(buff, njd_set_digit_rule_voiced_sound_symbol_list[i + 1]);
-            strcat(buff, &str[j]);
-            NJDNode_set_pron(node2, buff);
-            break;
-         }
+      str = NJDNode_get_pron(node2);
+      i = NJDTrie_find(&njd_set_digit_voiced_sound_symbol_trie, str, &j);
+      if (i >= 0) {
+         strcpy(buff, njd_set_digit_rule_voiced_sound_symbol_list[i + 1]);
+         strcat(buff, &str[j]);
+         NJDNode_set_pron(node2, buff);
       }
    } else if (type == 2) {
-      for (i = 0; njd_set_digit_rule_semivoiced_sound_symbol_list[i] != NULL; i += 2) {
-         str = NJDNode_get_pron(node2);
-         j = strtopcmp(str, njd_set_digit_rule_semivoiced_sound_symbol_list[i]);
-         if (j >= 0) {
-            strcpy(buff, njd_set_digit_rule_semivoiced_sound_symbol_list[i + 1]);
-            strcat(buff, &str[j]);
-            NJDNode_set_pron(node2, buff);
-            break;
-         }
+      str = NJDNode_get_pron(node2);
+      i = NJDTrie_find(&njd_set_digit_semivoiced_sound_symbol_trie, str, &j);
+      if (i >= 0) {
+         strcpy(buff, njd_set_digit_rule_semivoiced_sound_symbol_list[i + 1]);
+         strcat(buff, &str[j]);
+         NJDNode_set_pron(node2, buff);
       }
    }
 }
@@ -340,6 +428,8 @@ void njd_set_digit(NJD * njd)
    NJDNode *node;
    int find = 0;
 
+   NJDOnce_call(&njd_set_digit_trie_once, initialize_trie);
+
    /* convert digit sequence */
    for (node = njd->head; node != NULL; node = node->next) {
       if (get_digit(node, 1) >= 0) {
@@ -353,7 +443,7 @@ void njd_set_digit(NJD * njd)
             e = node->prev;
       }
       if (s != NULL && e != NULL) {
-         convert_digit_sequence(s, e);
+         convert_digit_sequence(njd, s, e);
          s = e = NULL;
       }
    }
@@ -388,37 +478,13 @@ void njd_set_digit(NJD * njd)
       if (strcmp(NJDNode_get_pos_group1(node->prev), NJD_SET_DIGIT_KAZU) == 0) {
          if (strcmp(NJDNode_get_pos_group2(node), NJD_SET_DIGIT_JOSUUSHI) == 0) {
             /* convert digit pron */
-            if (search_numerative_class(njd_set_digit_rule_numerative_class1b, node) == 1)
-               convert_digit_pron(njd_set_digit_rule_conv_table1b, node->prev);
-            else if (search_numerative_class(njd_set_digit_rule_numerative_class1c, node) == 1)
-               convert_digit_pron(njd_set_digit_rule_conv_table1c, node->prev);
-            else if (search_numerative_class(njd_set_digit_rule_numerative_class1d, node) == 1)
-               convert_digit_pron(njd_set_digit_rule_conv_table1d, node->prev);
-            else if (search_numerative_class(njd_set_digit_rule_numerative_class1e, node) == 1)
-               convert_digit_pron(njd_set_digit_rule_conv_table1e, node->prev);
-            else if (search_numerative_class(njd_set_digit_rule_numerative_class1f, node) == 1)
-               convert_digit_pron(njd_set_digit_rule_conv_table1f, node->prev);
-            else if (search_numerative_class(njd_set_digit_rule_numerative_class1g, node) == 1)
-               convert_digit_pron(njd_set_digit_rule_conv_table1g, node->prev);
-            else if (search_numerative_class(njd_set_digit_rule_numerative_class1h, node) == 1)
-               convert_digit_pron(njd_set_digit_rule_conv_table1h, node->prev);
-            else if (search_numerative_class(njd_set_digit_rule_numerative_class1i, node) == 1)
-               convert_digit_pron(njd_set_digit_rule_conv_table1i, node->prev);
-            else if (search_numerative_class(njd_set_digit_rule_numerative_class1j, node) == 1)
-               convert_digit_pron(njd_set_digit_rule_conv_table1j, node->prev);
-            else if (search_numerative_class(njd_set_digit_rule_numerative_class1k, node) == 1)
-               convert_digit_pron(njd_set_digit_rule_conv_table1k, node->prev);
+            i = search_class(&njd_set_digit_class1, node);
+            if (i >= 0)
+               convert_digit_pron(njd_set_digit_conv_table1[i], node->prev);
             /* convert numerative pron */
-            if (search_numerative_class(njd_set_digit_rule_numerative_class2b, node) == 1)
-               convert_numerative_pron(njd_set_digit_rule_conv_table2b, node->prev, node);
-            else if (search_numerative_class(njd_set_digit_rule_numerative_class2c, node) == 1)
-               convert_numerative_pron(njd_set_digit_rule_conv_table2c, node->prev, node);
-            else if (search_numerative_class(njd_set_digit_rule_numerative_class2d, node) == 1)
-               convert_numerative_pron(njd_set_digit_rule_conv_table2d, node->prev, node);
-            else if (search_numerative_class(njd_set_digit_rule_numerative_class2e, node) == 1)
-               convert_numerative_pron(njd_set_digit_rule_conv_table2e, node->prev, node);
-            else if (search_numerative_class(njd_set_digit_rule_numerative_class2f, node) == 1)
-               convert_numerative_pron(njd_set_digit_rule_conv_table2f, node->prev, node);
+            i = search_class(&njd_set_digit_class2, node);
+            if (i >= 0)
+               convert_numerative_pron(njd_set_digit_conv_table2[i], node->prev, node);
             /* modify accent phrase */
             NJDNode_set_chain_flag(node->prev, 0);
             NJDNode_set_chain_flag(node, 1);
@@ -431,34 +497,17 @@ void njd_set_digit(NJD * njd)
          if (strcmp(NJDNode_get_pos_group1(node), NJD_SET_DIGIT_KAZU) == 0
              && NJDNode_get_string(node->prev) != NULL && NJDNode_get_string(node) != NULL) {
             /* modify accent phrase */
-            find = 0;
-            for (i = 0; njd_set_digit_rule_numeral_list4[i] != NULL; i++) {
-               if (strcmp(NJDNode_get_string(node->prev), njd_set_digit_rule_numeral_list4[i]) == 0) {
-                  for (j = 0; njd_set_digit_rule_numeral_list5[j] != NULL; j++) {
-                     if (strcmp(NJDNode_get_string(node), njd_set_digit_rule_numeral_list5[j]) == 0) {
-                        NJDNode_set_chain_flag(node->prev, 0);
-                        NJDNode_set_chain_flag(node, 1);
-                        find = 1;
-                        break;
-                     }
-                  }
-                  break;
-               }
-            }
-            if (find == 0) {
-               for (i = 0; njd_set_digit_rule_numeral_list5[i] != NULL; i++) {
-                  if (strcmp(NJDNode_get_string(node->prev), njd_set_digit_rule_numeral_list5[i]) ==
-                      0) {
-                     for (j = 0; njd_set_digit_rule_numeral_list4[j] != NULL; j++) {
-                        if (strcmp(NJDNode_get_string(node), njd_set_digit_rule_numeral_list4[j]) ==
-                            0) {
-                           NJDNode_set_chain_flag(node, 0);
-                           break;
-                        }
-                     }
-                     break;
-                  }
-               }
+            if (NJDTrie_find_exact(&njd_set_digit_numeral_list4_trie,
+                                   NJDNode_get_string(node->prev)) >= 0
+                && NJDTrie_find_exact(&njd_set_digit_numeral_list5_trie,
+                                      NJDNode_get_string(node)) >= 0) {
+               NJDNode_set_chain_flag(node->prev, 0);
+               NJDNode_set_chain_flag(node, 1);
+            } else if (NJDTrie_find_exact(&njd_set_digit_numeral_list5_trie,
+                                          NJDNode_get_string(node->prev)) >= 0
+                       && NJDTrie_find_exact(&njd_set_digit_numeral_list4_trie,
+                                             NJDNode_get_string(node)) >= 0) {
+               NJDNode_set_chain_flag(node, 0);
             }
          }
          if (search_numerative_class(njd_set_digit_rule_numeral_list8, node) == 1)
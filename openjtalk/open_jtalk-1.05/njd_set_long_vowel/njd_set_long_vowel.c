@@ -68,20 +68,12 @@ NJD_SET_LONG_VOWEL_C_START;
 #error CHARSET is not specified
 #endif
 
-#define MAXBUFLEN 1024
+static NJDTrie njd_set_long_vowel_trie;
+static NJDOnce njd_set_long_vowel_trie_once = NJD_ONCE_INIT;
 
-static int strtopcmp(char *str, const char *pattern)
+static void initialize_trie(void)
 {
-   int i;
-
-   for (i = 0;; i++) {
-      if (pattern[i] == '\0')
-         return i;
-      if (str[i] == '\0')
-         return -1;
-      if (str[i] != pattern[i])
-         return -1;
-   }
+   NJDTrie_initialize(&njd_set_long_vowel_trie, njd_set_long_vowel_table, 2);
 }
 
 static int detect_byte(char *str)
@@ -97,46 +89,51 @@ static int detect_byte(char *str)
       }
    }
    if (byte < 0) {
-      fprintf(stderr, "ERROR: detect_byte() in njd_set_long_vowel.c: Wrong character.\n");
-      exit(1);
+      fprintf(stderr, "WARNING: detect_byte() in njd_set_long_vowel.c: Wrong character.\n");
+      byte = 1;
    }
    return byte;
 }
 
-void njd_set_long_vowel(NJD * njd)
+/* No replacement is longer than its pattern, so pron is rewritten in place. */
+void njd_set_long_vowel_node(NJDNode * node)
 {
-   int i, j;
-   NJDNode *node;
+   int j, byte;
+   size_t i, pos, len;
    char *str;
-   int len;
-   char buff[MAXBUFLEN];
-   int byte = -1;
-
-   for (node = njd->head; node != NULL; node = node->next) {
-      /* initialize */
-      str = NJDNode_get_pron(node);
-      len = strlen(str);
-      buff[0] = '\0';
-      /* search */
-      for (i = 0; i < len; i += byte) {
-         byte = -1;
-         for (j = 0; njd_set_long_vowel_table[j] != NULL; j += 2) {
-            byte = strtopcmp(&str[i], njd_set_long_vowel_table[j]);
-            if (byte > 0) {
-               /* find */
-               strcat(buff, njd_set_long_vowel_table[j + 1]);
-               break;
-            }
-         }
+   const char *rule;
+
+   NJDOnce_call(&njd_set_long_vowel_trie_once, initialize_trie);
+
+   str = NJDNode_get_pron(node);
+   if (str == NULL)
+      return;
+   len = strlen(str);
+   for (i = 0, pos = 0; i < len; i += byte) {
+      j = NJDTrie_find(&njd_set_long_vowel_trie, &str[i], &byte);
+      if (j >= 0) {
+         /* find */
+         rule = njd_set_long_vowel_table[j + 1];
+         memcpy(&str[pos], rule, strlen(rule));
+         pos += strlen(rule);
+      } else {
          /* not found */
-         if (byte < 0) {
-            byte = detect_byte(&str[i]);
-            strncat(buff, &str[i], byte);
-         }
+         byte = detect_byte(&str[i]);
+         if (i + byte > len)
+            byte = len - i;
+         memmove(&str[pos], &str[i], byte);
+         pos += byte;
       }
-      /* finish */
-      NJDNode_set_pron(node, buff);
    }
+   str[pos] = '\0';
+}
+
+void njd_set_long_vowel(NJD * njd)
+{
+   NJDNode *node;
+
+   for (node = njd->head; node != NULL; node = node->next)
+      njd_set_long_vowel_node(node);
 }
 
 NJD_SET_LONG_VOWEL_C_END;
@@ -53,6 +53,8 @@ NJD_SET_LONG_VOWEL_H_START;
 
 void njd_set_long_vowel(NJD * njd);
 
+void njd_set_long_vowel_node(NJDNode * node);
+
 NJD_SET_LONG_VOWEL_H_END;
 
 #endif                          /* !NJD_SET_LONG_VOWEL_H */
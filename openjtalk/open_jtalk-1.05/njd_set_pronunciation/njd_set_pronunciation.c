@@ -68,20 +68,14 @@ NJD_SET_PRONUNCIATION_C_START;
 #error CHARSET is not specified
 #endif
 
-#define MAXBUFLEN 1024
+static NJDTrie njd_set_pronunciation_trie;
+static NJDTrie njd_set_pronunciation_symbol_trie;
+static NJDOnce njd_set_pronunciation_trie_once = NJD_ONCE_INIT;
 
-static int strtopcmp(char *str, const char *pattern)
+static void initialize_trie(void)
 {
-   int i;
-
-   for (i = 0;; i++) {
-      if (pattern[i] == '\0')
-         return i;
-      if (str[i] == '\0')
-         return -1;
-      if (str[i] != pattern[i])
-         return -1;
-   }
+   NJDTrie_initialize(&njd_set_pronunciation_trie, njd_set_pronunciation_list, 3);
+   NJDTrie_initialize(&njd_set_pronunciation_symbol_trie, njd_set_pronunciation_symbol_list, 2);
 }
 
 void njd_set_pronunciation(NJD * njd)
@@ -92,27 +86,24 @@ void njd_set_pronunciation(NJD * njd)
    int pos;
    int len;
 
-   for (node = njd->head; node != NULL; node = node->next) {
+   NJDOnce_call(&njd_set_pronunciation_trie_once, initialize_trie);
+
+   for (node = njd->head; node != NULL;) {
       if (NJDNode_get_mora_size(node) == 0) {
          NJDNode_set_read(node, NULL);
          NJDNode_set_pron(node, NULL);
          if (strcmp(NJDNode_get_pos(node), NJD_SET_PRONUNCIATION_KIGOU) == 0 || strcmp(NJDNode_get_pos_group1(node), NJD_SET_PRONUNCIATION_KAZU) == 0) {        /* for symbol */
-            for (i = 0; njd_set_pronunciation_symbol_list[i] != NULL; i += 2)
-               if (strcmp(NJDNode_get_string(node), njd_set_pronunciation_symbol_list[i]) == 0) {
-                  NJDNode_set_read(node, (char *) njd_set_pronunciation_symbol_list[i + 1]);
-                  NJDNode_set_pron(node, (char *) njd_set_pronunciation_symbol_list[i + 1]);
-                  break;
-               }
+            i = NJDTrie_find_exact(&njd_set_pronunciation_symbol_trie, NJDNode_get_string(node));
+            if (i >= 0) {
+               NJDNode_set_read(node, (char *) njd_set_pronunciation_symbol_list[i + 1]);
+               NJDNode_set_pron(node, (char *) njd_set_pronunciation_symbol_list[i + 1]);
+            }
          } else if (NJDNode_get_pron(node) == NULL) {   /* for others */
             str = NJDNode_get_string(node);
             len = strlen(str);
             for (pos = 0; pos < len;) {
-               for (i = 0, j = 0; njd_set_pronunciation_list[i] != NULL; i += 3) {
-                  j = strtopcmp(&str[pos], njd_set_pronunciation_list[i]);
-                  if (j > 0)
-                     break;
-               }
-               if (j > 0) {
+               i = NJDTrie_find(&njd_set_pronunciation_trie, &str[pos], &j);
+               if (i >= 0) {
                   pos += j;
                   NJDNode_add_read(node, (char *) njd_set_pronunciation_list[i + 1]);
                   NJDNode_add_pron(node, (char *) njd_set_pronunciation_list[i + 1]);
@@ -123,8 +114,13 @@ void njd_set_pronunciation(NJD * njd)
             }
          }
       }
+      /* remove silent node here instead of NJD_remove_silent_node() in another traversal */
+      str = NJDNode_get_pron(node);
+      if (str == NULL || str[0] == '\0')
+         node = NJD_remove_node(njd, node);
+      else
+         node = node->next;
    }
-   NJD_remove_silent_node(njd);
 }
 
 NJD_SET_PRONUNCIATION_C_END;
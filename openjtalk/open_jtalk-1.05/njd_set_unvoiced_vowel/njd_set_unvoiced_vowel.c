@@ -68,8 +68,6 @@ NJD_SET_UNVOICED_VOWEL_C_START;
 #error CHARSET is not specified
 #endif
 
-#define MAXBUFLEN 1024
-
 static int strtopcmp(char *str, const char *pattern)
 {
    int i;
@@ -84,151 +82,222 @@ static int strtopcmp(char *str, const char *pattern)
    }
 }
 
+static NJDTrie njd_set_unvoiced_vowel_jodoushi_trie;
+static NJDTrie njd_set_unvoiced_vowel_candidate_trie;
+static NJDTrie njd_set_unvoiced_vowel_next_mora_trie;
+static NJDTrie njd_set_unvoiced_vowel_mora_trie;
+static NJDOnce njd_set_unvoiced_vowel_trie_once = NJD_ONCE_INIT;
+
 static int check_next_mora(char *str)
 {
-   int i;
+   int len;
 
-   for (i = 0; njd_set_unvoiced_vowel_next_mora_list[i] != NULL; i++) {
-      if (strtopcmp(str, njd_set_unvoiced_vowel_next_mora_list[i]) > 0)
-         return 1;
-   }
+   if (NJDTrie_find(&njd_set_unvoiced_vowel_next_mora_trie, str, &len) >= 0)
+      return 1;
    return 0;
 }
 
-static int strcat_unvoiced(char *buff, const char *str, int *last_unvoiced_flag, int *mora_in_word,
-                           int *mora_in_accent_phrase)
+static int strcat_unvoiced(char *buff, size_t *pos, const char *str, int *last_unvoiced_flag,
+                           int *mora_in_word, int *mora_in_accent_phrase)
 {
-   strcat(buff, str);
-   strcat(buff, NJD_SET_UNVOICED_VOWEL_QUOTATION);
+   size_t len = strlen(str);
+
+   memcpy(&buff[*pos], str, len);
+   *pos += len;
+   memcpy(&buff[*pos], NJD_SET_UNVOICED_VOWEL_QUOTATION, strlen(NJD_SET_UNVOICED_VOWEL_QUOTATION));
+   *pos += strlen(NJD_SET_UNVOICED_VOWEL_QUOTATION);
    *last_unvoiced_flag = 1;
    *mora_in_word += 1;
    *mora_in_accent_phrase += 1;
-   return strlen(str);
+   return len;
 }
 
-static int strcat_skip(char *buff, char *str, int *last_unvoiced_flag, int *mora_in_word,
-                       int *mora_in_accent_phrase)
+static int strcat_skip(char *buff, size_t *pos, char *str, int *last_unvoiced_flag,
+                       int *mora_in_word, int *mora_in_accent_phrase)
 {
    int i, byte;
+   const char *symbol;
 
-   for (i = 0; njd_set_unvoiced_vowel_mora_list[i] != NULL; i++) {
-      byte = strtopcmp(str, njd_set_unvoiced_vowel_mora_list[i]);
-      if (byte > 0) {
-         strncat(buff, njd_set_unvoiced_vowel_mora_list[i], byte);
-         *last_unvoiced_flag = 0;
-         *mora_in_word += 1;
-         *mora_in_accent_phrase += 1;
-         return strlen(njd_set_unvoiced_vowel_mora_list[i]);
-      }
+   i = NJDTrie_find(&njd_set_unvoiced_vowel_mora_trie, str, &byte);
+   if (i >= 0) {
+      memcpy(&buff[*pos], njd_set_unvoiced_vowel_mora_list[i], byte);
+      *pos += byte;
+      *last_unvoiced_flag = 0;
+      *mora_in_word += 1;
+      *mora_in_accent_phrase += 1;
+      return byte;
    }
    if (strtopcmp(str, NJD_SET_UNVOICED_VOWEL_TOUTEN) > 0) {
-      strcat(buff, NJD_SET_UNVOICED_VOWEL_TOUTEN);
+      symbol = NJD_SET_UNVOICED_VOWEL_TOUTEN;
       *last_unvoiced_flag = 0;
-      return strlen(NJD_SET_UNVOICED_VOWEL_TOUTEN);
-   }
-   if (strtopcmp(str, NJD_SET_UNVOICED_VOWEL_QUESTION) > 0) {
-      strcat(buff, NJD_SET_UNVOICED_VOWEL_QUESTION);
+   } else if (strtopcmp(str, NJD_SET_UNVOICED_VOWEL_QUESTION) > 0) {
+      symbol = NJD_SET_UNVOICED_VOWEL_QUESTION;
       *last_unvoiced_flag = 0;
-      return strlen(NJD_SET_UNVOICED_VOWEL_QUESTION);
-   }
-   if (strtopcmp(str, NJD_SET_UNVOICED_VOWEL_QUOTATION) > 0) {
-      strcat(buff, NJD_SET_UNVOICED_VOWEL_QUOTATION);
+   } else if (strtopcmp(str, NJD_SET_UNVOICED_VOWEL_QUOTATION) > 0) {
+      symbol = NJD_SET_UNVOICED_VOWEL_QUOTATION;
       *last_unvoiced_flag = 1;
-      return strlen(NJD_SET_UNVOICED_VOWEL_QUOTATION);
+   } else {
+      fprintf(stderr, "WARNING: strcat_voiced() in njd_set_unvoiced_vowel.c: Wrong pron.");
+      return 1;
    }
-   fprintf(stderr, "WARNING: strcat_voiced() in njd_set_unvoiced_vowel.c: Wrong pron.");
-   return 1;
+   memcpy(&buff[*pos], symbol, strlen(symbol));
+   *pos += strlen(symbol);
+   return strlen(symbol);
 }
 
-static void set_unvoiced_vowel(NJDNode * node, int *acc_in_accent_phrase,
-                               int *mora_in_accent_phrase, int *last_unvoiced_flag)
+/* Return buffer which has at least 'size' bytes, or NULL. */
+static char *get_buffer(NJDSetUnvoicedVowel * s, size_t size)
+{
+   char *buff;
+
+   if (size <= NJD_SET_UNVOICED_VOWEL_BUFLEN)
+      return s->local;
+   if (size > s->heap_size) {
+      if (size < s->heap_size * 2)
+         size = s->heap_size * 2;
+      buff = (char *) malloc(size);
+      if (buff == NULL) {
+         fprintf(stderr,
+                 "WARNING: get_buffer() in njd_set_unvoiced_vowel.c: Cannot allocate memory.\n");
+         return NULL;
+      }
+      if (s->heap != NULL)
+         free(s->heap);
+      s->heap = buff;
+      s->heap_size = size;
+   }
+   return s->heap;
+}
+
+static void set_unvoiced_vowel(NJDNode * node, NJDSetUnvoicedVowel * s)
 {
    int i, j;
    int len, mora_in_word;
-   char buff[MAXBUFLEN];
+   int byte;
+   size_t pos;
+   char *buff;
    char *str;
    const char *tmp;
    int find;
+   int *acc_in_accent_phrase = &s->acc_in_accent_phrase;
+   int *mora_in_accent_phrase = &s->mora_in_accent_phrase;
+   int *last_unvoiced_flag = &s->last_unvoiced_flag;
 
    /* initialize */
    str = NJDNode_get_pron(node);
-   buff[0] = '\0';
 
    /* Rule 1 */
    if (strcmp(NJDNode_get_pos(node), NJD_SET_UNVOICED_VOWEL_JODOUSHI) == 0) {
-      for (i = 0; njd_set_unvoiced_vowel_jodoushi_table[i] != NULL; i += 3) {
-         if (strcmp(str, njd_set_unvoiced_vowel_jodoushi_table[i]) == 0) {
-            NJDNode_set_pron(node, (char *) njd_set_unvoiced_vowel_jodoushi_table[i + 1]);
-            *mora_in_accent_phrase += atoi(njd_set_unvoiced_vowel_jodoushi_table[i + 2]);
-            *last_unvoiced_flag = 1;
-            return;
-         }
+      i = NJDTrie_find_exact(&njd_set_unvoiced_vowel_jodoushi_trie, str);
+      if (i >= 0) {
+         NJDNode_set_pron(node, (char *) njd_set_unvoiced_vowel_jodoushi_table[i + 1]);
+         *mora_in_accent_phrase += atoi(njd_set_unvoiced_vowel_jodoushi_table[i + 2]);
+         *last_unvoiced_flag = 1;
+         return;
       }
    }
 
+   /* each step consumes at least one byte and adds at most one quotation */
    len = strlen(str);
+   buff = get_buffer(s, len * (1 + strlen(NJD_SET_UNVOICED_VOWEL_QUOTATION)) + 1);
+   if (buff == NULL)
+      return;
+   pos = 0;
    mora_in_word = 0;
    for (i = 0; i < len;) {
       if (*last_unvoiced_flag == 1) {
          /* Rule 2 */
-         i += strcat_skip(buff, &str[i], last_unvoiced_flag, &mora_in_word, mora_in_accent_phrase);
+         i += strcat_skip(buff, &pos, &str[i], last_unvoiced_flag, &mora_in_word,
+                          mora_in_accent_phrase);
       } else if (*acc_in_accent_phrase == *mora_in_accent_phrase + 1) {
          /* Rule 3 */
-         i += strcat_skip(buff, &str[i], last_unvoiced_flag, &mora_in_word, mora_in_accent_phrase);
+         i += strcat_skip(buff, &pos, &str[i], last_unvoiced_flag, &mora_in_word,
+                          mora_in_accent_phrase);
       } else {
          /* Rule 4 */
-         tmp = NULL;
-         for (j = 0; njd_set_unvoiced_vowel_mora_list[j] != NULL; j++) {
-            if (strtopcmp(&str[i], njd_set_unvoiced_vowel_mora_list[j]) > 0) {
-               tmp = njd_set_unvoiced_vowel_mora_list[j];
-               break;
-            }
-         }
+         j = NJDTrie_find(&njd_set_unvoiced_vowel_mora_trie, &str[i], &byte);
+         tmp = j >= 0 ? njd_set_unvoiced_vowel_mora_list[j] : NULL;
          if (tmp == NULL) {
             /* unknown mora */
-            i += strcat_skip(buff, &str[i], last_unvoiced_flag, &mora_in_word,
+            i += strcat_skip(buff, &pos, &str[i], last_unvoiced_flag, &mora_in_word,
                              mora_in_accent_phrase);
          } else {
             find = 0;
-            for (j = 0; njd_set_unvoiced_vowel_candidate_list[j] != NULL; j++) {
-               if (strcmp(tmp, njd_set_unvoiced_vowel_candidate_list[j]) == 0) {
-                  if (check_next_mora(&str[i + strlen(tmp)]) == 1) {
-                     find = 1;
-                  } else if (NJDNode_get_mora_size(node) == mora_in_word + 1 && node->next != NULL
-                             && check_next_mora(NJDNode_get_pron(node->next)) == 1) {
-                     find = 1;
-                  } else {
-                     find = 0;
-                  }
-                  break;
+            j = NJDTrie_find_exact(&njd_set_unvoiced_vowel_candidate_trie, tmp);
+            if (j >= 0) {
+               if (check_next_mora(&str[i + byte]) == 1) {
+                  find = 1;
+               } else if (NJDNode_get_mora_size(node) == mora_in_word + 1 && node->next != NULL
+                          && check_next_mora(NJDNode_get_pron(node->next)) == 1) {
+                  find = 1;
+               } else {
+                  find = 0;
                }
             }
             if (find == 1)      /* unvoiced */
-               i += strcat_unvoiced(buff, njd_set_unvoiced_vowel_candidate_list[j],
+               i += strcat_unvoiced(buff, &pos, njd_set_unvoiced_vowel_candidate_list[j],
                                     last_unvoiced_flag, &mora_in_word, mora_in_accent_phrase);
             else                /* skip */
-               i += strcat_skip(buff, &str[i], last_unvoiced_flag, &mora_in_word,
+               i += strcat_skip(buff, &pos, &str[i], last_unvoiced_flag, &mora_in_word,
                                 mora_in_accent_phrase);
          }
       }
    }
-   NJDNode_set_pron(node, buff);
+   buff[pos] = '\0';
+   /* most of prons have no unvoiced vowel */
+   if (strcmp(buff, str) != 0)
+      NJDNode_set_pron(node, buff);
+}
+
+static void initialize_trie(void)
+{
+   NJDTrie_initialize(&njd_set_unvoiced_vowel_jodoushi_trie,
+                      njd_set_unvoiced_vowel_jodoushi_table, 3);
+   NJDTrie_initialize(&njd_set_unvoiced_vowel_candidate_trie,
+                      njd_set_unvoiced_vowel_candidate_list, 1);
+   NJDTrie_initialize(&njd_set_unvoiced_vowel_next_mora_trie,
+                      njd_set_unvoiced_vowel_next_mora_list, 1);
+   NJDTrie_initialize(&njd_set_unvoiced_vowel_mora_trie, njd_set_unvoiced_vowel_mora_list, 1);
+}
+
+void njd_set_unvoiced_vowel_initialize(NJDSetUnvoicedVowel * s)
+{
+   NJDOnce_call(&njd_set_unvoiced_vowel_trie_once, initialize_trie);
+   s->acc_in_accent_phrase = 0;
+   s->mora_in_accent_phrase = 0;
+   s->last_unvoiced_flag = 0;
+   s->heap = NULL;
+   s->heap_size = 0;
+}
+
+/* Accent type of the accent phrase which 'node' belongs to must be fixed, and pron of the next
+   node must not be changed yet. */
+void njd_set_unvoiced_vowel_node(NJDNode * node, NJDSetUnvoicedVowel * s)
+{
+   if (NJDNode_get_chain_flag(node) <= 0) {
+      s->acc_in_accent_phrase = NJDNode_get_acc(node);
+      s->mora_in_accent_phrase = 0;
+   }
+   set_unvoiced_vowel(node, s);
+}
+
+void njd_set_unvoiced_vowel_clear(NJDSetUnvoicedVowel * s)
+{
+   if (s->heap != NULL)
+      free(s->heap);
+   s->heap = NULL;
+   s->heap_size = 0;
 }
 
 void njd_set_unvoiced_vowel(NJD * njd)
 {
-   int acc_in_accent_phrase = 0;
-   int mora_in_accent_phrase = 0;
-   int last_unvoiced_flag = 0;
    NJDNode *node;
+   NJDSetUnvoicedVowel s;
 
-   for (node = njd->head; node != NULL; node = node->next) {
-      if (NJDNode_get_chain_flag(node) <= 0) {
-         acc_in_accent_phrase = NJDNode_get_acc(node);
-         mora_in_accent_phrase = 0;
-      }
-      set_unvoiced_vowel(node, &acc_in_accent_phrase, &mora_in_accent_phrase, &last_unvoiced_flag);
-   }
+   njd_set_unvoiced_vowel_initialize(&s);
+   for (node = njd->head; node != NULL; node = node->next)
+      njd_set_unvoiced_vowel_node(node, &s);
+   njd_set_unvoiced_vowel_clear(&s);
 }
 
 NJD_SET_UNVOICED_VOWEL_C_END;
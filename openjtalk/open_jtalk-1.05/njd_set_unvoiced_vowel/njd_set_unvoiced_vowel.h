@@ -51,8 +51,27 @@
 
 NJD_SET_UNVOICED_VOWEL_H_START;
 
+/* size of the buffer for usual prons, longer ones are written to heap */
+#define NJD_SET_UNVOICED_VOWEL_BUFLEN 1024
+
+/* state carried from a node to the next one */
+typedef struct _NJDSetUnvoicedVowel {
+   int acc_in_accent_phrase;
+   int mora_in_accent_phrase;
+   int last_unvoiced_flag;
+   char local[NJD_SET_UNVOICED_VOWEL_BUFLEN];
+   char *heap;
+   size_t heap_size;
+} NJDSetUnvoicedVowel;
+
 void njd_set_unvoiced_vowel(NJD * njd);
 
+void njd_set_unvoiced_vowel_initialize(NJDSetUnvoicedVowel * s);
+
+void njd_set_unvoiced_vowel_node(NJDNode * node, NJDSetUnvoicedVowel * s);
+
+void njd_set_unvoiced_vowel_clear(NJDSetUnvoicedVowel * s);
+
 NJD_SET_UNVOICED_VOWEL_H_END;
 
 #endif                          /* !NJD_SET_UNVOICED_VOWEL_H */
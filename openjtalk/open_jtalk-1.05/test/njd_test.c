@@ -0,0 +1,141 @@
+/* ----------------------------------------------------------------- */
+/*           The Japanese TTS System "Open JTalk"                    */
+/*           developed by HTS Working Group                          */
+/*           http://open-jtalk.sourceforge.net/                      */
+/* ----------------------------------------------------------------- */
+/*                                                                   */
+/*  Copyright (c) 2008-2011  Nagoya Institute of Technology          */
+/*                           Department of Computer Science          */
+/*                                                                   */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/* - Redistributions of source code must retain the above copyright  */
+/*   notice, this list of conditions and the following disclaimer.   */
+/* - Redistributions in binary form must reproduce the above         */
+/*   copyright notice, this list of conditions and the following     */
+/*   disclaimer in the documentation and/or other materials provided */
+/*   with the distribution.                                          */
+/* - Neither the name of the HTS working group nor the names of its  */
+/*   contributors may be used to endorse or promote products derived */
+/*   from this software without specific prior written permission.   */
+/*                                                                   */
+/* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND            */
+/* CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,       */
+/* INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF          */
+/* MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE          */
+/* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS */
+/* BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,          */
+/* EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED   */
+/* TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,     */
+/* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON */
+/* ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,   */
+/* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY    */
+/* OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE           */
+/* POSSIBILITY OF SUCH DAMAGE.                                       */
+/* ----------------------------------------------------------------- */
+
+/* Reads MeCab features of sentences ("surface,feature" per line, "EOS" at the end of each
+   sentence), runs the NJD passes and prints the resulting NJD nodes and labels so that the
+   output can be compared with a reference. Lines starting with '#' are copied as they are.
+   With -f, njd_set_accent_and_vowel() is used instead of the four passes it fuses, and the
+   output must be the same. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "njd.h"
+#include "jpcommon.h"
+#include "mecab2njd.h"
+#include "njd_set_pronunciation.h"
+#include "njd_set_digit.h"
+#include "njd_set_accent_phrase.h"
+#include "njd_set_accent_type.h"
+#include "njd_set_unvoiced_vowel.h"
+#include "njd_set_long_vowel.h"
+#include "njd_set_accent_and_vowel.h"
+#include "njd2jpcommon.h"
+
+#define MAXBUFLEN 1024
+#define MAXWORDNUM 1024
+
+static void analysis(NJD * njd, JPCommon * jpcommon, char **feature, int size, int fused,
+                     FILE * fp)
+{
+   int i;
+
+   mecab2njd(njd, feature, size);
+   njd_set_pronunciation(njd);
+   njd_set_digit(njd);
+   if (fused) {
+      njd_set_accent_and_vowel(njd);
+   } else {
+      njd_set_accent_phrase(njd);
+      njd_set_accent_type(njd);
+      njd_set_unvoiced_vowel(njd);
+      njd_set_long_vowel(njd);
+   }
+   njd2jpcommon(jpcommon, njd);
+   JPCommon_make_label(jpcommon);
+
+   NJD_fprint(njd, fp);
+   for (i = 0; i < JPCommon_get_label_size(jpcommon); i++)
+      fprintf(fp, "%s\n", JPCommon_get_label_feature(jpcommon)[i]);
+   fprintf(fp, "\n");
+
+   JPCommon_refresh(jpcommon);
+   NJD_refresh(njd);
+}
+
+int main(int argc, char **argv)
+{
+   FILE *fp = stdin;
+   NJD njd;
+   JPCommon jpcommon;
+   char buff[MAXBUFLEN];
+   char *feature[MAXWORDNUM];
+   int size = 0;
+   int fused = 0;
+   int i;
+
+   if (argc > 1 && strcmp(argv[1], "-f") == 0) {
+      fused = 1;
+      argc--;
+      argv++;
+   }
+   if (argc > 1 && (fp = fopen(argv[1], "r")) == NULL) {
+      fprintf(stderr, "ERROR: Cannot open %s.\n", argv[1]);
+      return 1;
+   }
+
+   NJD_initialize(&njd);
+   JPCommon_initialize(&jpcommon);
+
+   while (fgets(buff, MAXBUFLEN, fp) != NULL) {
+      buff[strcspn(buff, "\r\n")] = '\0';
+      if (buff[0] == '#') {
+         printf("%s\n", buff);
+      } else if (strcmp(buff, "EOS") == 0) {
+         analysis(&njd, &jpcommon, feature, size, fused, stdout);
+         for (i = 0; i < size; i++)
+            free(feature[i]);
+         size = 0;
+      } else if (buff[0] != '\0' && size < MAXWORDNUM) {
+         feature[size] = (char *) malloc(strlen(buff) + 1);
+         strcpy(feature[size++], buff);
+      }
+   }
+   for (i = 0; i < size; i++)
+      free(feature[i]);
+
+   JPCommon_clear(&jpcommon);
+   NJD_clear(&njd);
+   if (fp != stdin)
+      fclose(fp);
+
+   return 0;
+}
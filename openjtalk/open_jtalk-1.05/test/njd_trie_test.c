@@ -0,0 +1,132 @@
+/* ----------------------------------------------------------------- */
+/*           The Japanese TTS System "Open JTalk"                    */
+/*           developed by HTS Working Group                          */
+/*           http://open-jtalk.sourceforge.net/                      */
+/* ----------------------------------------------------------------- */
+/*                                                                   */
+/*  Copyright (c) 2008-2011  Nagoya Institute of Technology          */
+/*                           Department of Computer Science          */
+/*                                                                   */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/* - Redistributions of source code must retain the above copyright  */
+/*   notice, this list of conditions and the following disclaimer.   */
+/* - Redistributions in binary form must reproduce the above         */
+/*   copyright notice, this list of conditions and the following     */
+/*   disclaimer in the documentation and/or other materials provided */
+/*   with the distribution.                                          */
+/* - Neither the name of the HTS working group nor the names of its  */
+/*   contributors may be used to endorse or promote products derived */
+/*   from this software without specific prior written permission.   */
+/*                                                                   */
+/* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND            */
+/* CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,       */
+/* INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF          */
+/* MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE          */
+/* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS */
+/* BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,          */
+/* EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED   */
+/* TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,     */
+/* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON */
+/* ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,   */
+/* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY    */
+/* OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE           */
+/* POSSIBILITY OF SUCH DAMAGE.                                       */
+/* ----------------------------------------------------------------- */
+/* Checks NJDTrie on a small rule list: overlapping prefixes, duplicated patterns, exact matches
+   against prefix-only matches, inputs without a match and multibyte keys. Prints PASS or FAIL
+   for each case and returns non-zero if any case fails. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "njd.h"
+
+/* multibyte keys are UTF-8 bytes, so that they share their leading bytes whatever the charset */
+#define KEY_A    "\xe3\x82\xa2"         /* katakana a */
+#define KEY_I    "\xe3\x82\xa4"         /* katakana i */
+#define KEY_U    "\xe3\x82\xa6"         /* katakana u, not in the list */
+#define KEY_LONG "\xe3\x83\xbc"         /* long vowel mark */
+
+/* pattern and value; the list index of a rule is twice its row */
+static const char *njd_trie_test_list[] = {
+   "ab", "0",
+   "abc", "1",
+   "a", "2",
+   "abc", "3",
+   "b", "4",
+   KEY_A, "5",
+   KEY_A KEY_LONG, "6",
+   KEY_I, "7",
+   NULL, NULL
+};
+
+static int failed = 0;
+
+static void check_find(NJDTrie * trie, const char *name, const char *str, int rule, int len)
+{
+   int result;
+   int result_len = -1;
+
+   result = NJDTrie_find(trie, str, &result_len);
+   if (result == rule && (rule < 0 || result_len == len)) {
+      printf("PASS: trie %s\n", name);
+   } else {
+      printf("FAIL: trie %s (rule %d, length %d; expected rule %d, length %d)\n", name, result,
+             result_len, rule, len);
+      failed++;
+   }
+}
+
+static void check_find_exact(NJDTrie * trie, const char *name, const char *str, int rule)
+{
+   int result;
+
+   result = NJDTrie_find_exact(trie, str);
+   if (result == rule) {
+      printf("PASS: trie %s\n", name);
+   } else {
+      printf("FAIL: trie %s (rule %d; expected rule %d)\n", name, result, rule);
+      failed++;
+   }
+}
+
+int main(void)
+{
+   NJDTrie trie;
+
+   NJDTrie_initialize(&trie, njd_trie_test_list, 2);
+
+   /* "a", "ab" and "abc" are all heads of the input, and "ab" comes first in the list */
+   check_find(&trie, "overlapping prefixes", "abcd", 0, 2);
+   check_find(&trie, "shortest prefix", "a", 4, 1);
+   check_find(&trie, "prefix before a mismatch", "abx", 0, 2);
+   check_find_exact(&trie, "duplicated pattern", "abc", 2);
+
+   /* the exact search ignores rules which only match a head of the input */
+   check_find_exact(&trie, "exact match", "ab", 0);
+   check_find_exact(&trie, "exact match of a shorter pattern", "a", 4);
+   check_find_exact(&trie, "prefix-only match", "abcd", -1);
+   check_find_exact(&trie, "inside a pattern", "bc", -1);
+
+   check_find(&trie, "no match", "xyz", -1, 0);
+   check_find(&trie, "empty string", "", -1, 0);
+   check_find(&trie, "NULL string", NULL, -1, 0);
+   check_find_exact(&trie, "no exact match", "x", -1);
+
+   /* KEY_A, KEY_I and KEY_U share their first two bytes */
+   check_find(&trie, "multibyte prefix", KEY_A KEY_LONG KEY_I, 10, 3);
+   check_find(&trie, "multibyte sibling", KEY_I KEY_A, 14, 3);
+   check_find(&trie, "multibyte mismatch", KEY_U, -1, 0);
+   check_find_exact(&trie, "multibyte exact match", KEY_A KEY_LONG, 12);
+   check_find_exact(&trie, "partial multibyte character", "\xe3\x82", -1);
+
+   NJDTrie_clear(&trie);
+
+   return failed == 0 ? 0 : 1;
+}
@@ -52,8 +52,10 @@
 TEXT2MECAB_C_START;
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
+#include "njd.h"
 #include "text2mecab.h"
 
 #if defined(CHARSET_EUC_JP)
@@ -66,18 +68,13 @@ TEXT2MECAB_C_START;
 #error CHARSET is not specified
 #endif
 
-static int strtopcmp(const char *str, const char *pattern)
-{
-   int i;
+/* conversion list is compiled once into a byte trie, which is shared by threads */
+static NJDTrie text2mecab_trie;
+static NJDOnce text2mecab_trie_once = NJD_ONCE_INIT;
 
-   for (i = 0;; i++) {
-      if (pattern[i] == '\0')
-         return i;
-      if (str[i] == '\0')
-         return -1;
-      if (str[i] != pattern[i])
-         return -1;
-   }
+static void initialize_trie(void)
+{
+   NJDTrie_initialize(&text2mecab_trie, text2mecab_conv_list, 2);
 }
 
 void text2mecab(char *output, const char *input)
@@ -88,15 +85,13 @@ void text2mecab(char *output, const char *input)
    int index = 0;
    int s, e = -1;
 
+   NJDOnce_call(&text2mecab_trie_once, initialize_trie);
+
    for (s = 0; s < length;) {
       str = &input[s];
       /* search */
-      for (i = 0; text2mecab_conv_list[i] != NULL; i += 2) {
-         e = strtopcmp(str, text2mecab_conv_list[i]);
-         if (e != -1)
-            break;
-      }
-      if (e != -1) {
+      i = NJDTrie_find(&text2mecab_trie, str, &e);
+      if (i >= 0) {
          /* convert */
          s += e;
          str = text2mecab_conv_list[i + 1];
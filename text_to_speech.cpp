@@ -50,6 +50,7 @@
 #include "njd_set_accent_type.h"
 #include "njd_set_unvoiced_vowel.h"
 #include "njd_set_long_vowel.h"
+#include "njd_set_accent_and_vowel.h"
 #include "njd2jpcommon.h"
 
 /* c headers */
@@ -146,13 +147,10 @@ void TextToSpeech::synthesis(char *txt, FILE * wavfp)
 
 	text2mecab(buff, txt);
 	Mecab_analysis(&open_jtalk_.mecab, buff);
-	mecab2njd(&open_jtalk_.njd, Mecab_get_feature(&open_jtalk_.mecab), Mecab_get_size(&open_jtalk_.mecab));
+	mecab2njd_from_node(&open_jtalk_.njd, Mecab_get_node(&open_jtalk_.mecab));
 	njd_set_pronunciation(&open_jtalk_.njd);
 	njd_set_digit(&open_jtalk_.njd);
-	njd_set_accent_phrase(&open_jtalk_.njd);
-	njd_set_accent_type(&open_jtalk_.njd);
-	njd_set_unvoiced_vowel(&open_jtalk_.njd);
-	njd_set_long_vowel(&open_jtalk_.njd);
+	njd_set_accent_and_vowel(&open_jtalk_.njd);
 	njd2jpcommon(&open_jtalk_.jpcommon, &open_jtalk_.njd);
 	JPCommon_make_label(&open_jtalk_.jpcommon);
 	if (JPCommon_get_label_size(&open_jtalk_.jpcommon) > 2) {